@@ -258,3 +258,43 @@ const uint8_t PROGMEM font5x7[] = {
   0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+// unicode codepoints of the code page 437 glyphs above 0x7F, sorted
+// (the table above lacks glyph 0xB2, later glyphs sit one index lower)
+const uint16_t PROGMEM font5x7_map_cp[] = {
+  0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A5, 0x00AA, 0x00AB, 0x00AC,
+  0x00B0, 0x00B1, 0x00B2, 0x00B5, 0x00B7, 0x00BA, 0x00BB, 0x00BC,
+  0x00BD, 0x00BF, 0x00C4, 0x00C5, 0x00C6, 0x00C7, 0x00C9, 0x00D1,
+  0x00D6, 0x00DC, 0x00DF, 0x00E0, 0x00E1, 0x00E2, 0x00E4, 0x00E5,
+  0x00E6, 0x00E7, 0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED,
+  0x00EE, 0x00EF, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F6, 0x00F7,
+  0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FF, 0x0192, 0x0393, 0x0398,
+  0x03A3, 0x03A6, 0x03A9, 0x03B1, 0x03B4, 0x03B5, 0x03C0, 0x03C3,
+  0x03C4, 0x03C6, 0x207F, 0x20A7, 0x2219, 0x221A, 0x221E, 0x2229,
+  0x2248, 0x2261, 0x2264, 0x2265, 0x2310, 0x2320, 0x2321, 0x2500,
+  0x2502, 0x250C, 0x2510, 0x2514, 0x2518, 0x251C, 0x2524, 0x252C,
+  0x2534, 0x253C, 0x2550, 0x2551, 0x2552, 0x2553, 0x2554, 0x2555,
+  0x2556, 0x2557, 0x2558, 0x2559, 0x255A, 0x255B, 0x255C, 0x255D,
+  0x255E, 0x255F, 0x2560, 0x2561, 0x2562, 0x2563, 0x2564, 0x2565,
+  0x2566, 0x2567, 0x2568, 0x2569, 0x256A, 0x256B, 0x256C, 0x2580,
+  0x2584, 0x2588, 0x258C, 0x2590, 0x2591, 0x2592, 0x2593, 0x25A0,
+};
+
+// glyph index of each codepoint in font5x7_map_cp
+const uint8_t PROGMEM font5x7_map_glyph[] = {
+  0xFE, 0xAD, 0x9B, 0x9C, 0x9D, 0xA6, 0xAE, 0xAA,
+  0xF7, 0xF0, 0xFC, 0xE5, 0xF9, 0xA7, 0xAF, 0xAC,
+  0xAB, 0xA8, 0x8E, 0x8F, 0x92, 0x80, 0x90, 0xA5,
+  0x99, 0x9A, 0xE0, 0x85, 0xA0, 0x83, 0x84, 0x86,
+  0x91, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1,
+  0x8C, 0x8B, 0xA4, 0x95, 0xA2, 0x93, 0x94, 0xF5,
+  0x97, 0xA3, 0x96, 0x81, 0x98, 0x9F, 0xE1, 0xE8,
+  0xE3, 0xE7, 0xE9, 0xDF, 0xEA, 0xED, 0xE2, 0xE4,
+  0xE6, 0xEC, 0xFB, 0x9E, 0xF8, 0xFA, 0xEB, 0xEE,
+  0xF6, 0xEF, 0xF2, 0xF1, 0xA9, 0xF3, 0xF4, 0xC3,
+  0xB2, 0xD9, 0xBE, 0xBF, 0xD8, 0xC2, 0xB3, 0xC1,
+  0xC0, 0xC4, 0xCC, 0xB9, 0xD4, 0xD5, 0xC8, 0xB7,
+  0xB6, 0xBA, 0xD3, 0xD2, 0xC7, 0xBD, 0xBC, 0xBB,
+  0xC5, 0xC6, 0xCB, 0xB4, 0xB5, 0xB8, 0xD0, 0xD1,
+  0xCA, 0xCE, 0xCF, 0xC9, 0xD7, 0xD6, 0xCD, 0xDE,
+  0xDB, 0xDA, 0xDC, 0xDD, 0xB0, 0xB1, 0xB1, 0xFD,
+};
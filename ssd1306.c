@@ -20,25 +20,61 @@
 
 #include "ssd1306.h"
 
+// configured bus needs its driver
+#if defined (SSD1306_CONFIG_BUS) && (SSD1306_CONFIG_BUS == SSD1306_BUS_I2C) && !defined (SSD1306_I2C)
+	#error "SSD1306_CONFIG_BUS is i2c, build with SSD1306_I2C"
+#endif
+#if defined (SSD1306_CONFIG_BUS) && (SSD1306_CONFIG_BUS == SSD1306_BUS_SPI) && !defined (SSD1306_SPI)
+	#error "SSD1306_CONFIG_BUS is spi, build with SSD1306_SPI"
+#endif
+
+// configured geometry must be a supported panel
+#if defined (SSD1306_CONFIG_WIDTH) && ((SSD1306_CONFIG_WIDTH < 1) || (SSD1306_CONFIG_WIDTH > SSD1306_OLED_WIDTH_MAX))
+	#error "SSD1306_CONFIG_WIDTH out of range"
+#endif
+#if defined (SSD1306_CONFIG_HEIGHT) && ((SSD1306_CONFIG_HEIGHT < 8) || (SSD1306_CONFIG_HEIGHT > SSD1306_OLED_HEIGHT_MAX) || (SSD1306_CONFIG_HEIGHT % 8))
+	#error "SSD1306_CONFIG_HEIGHT out of range"
+#endif
+
 #include "font5x7.h"
 #include "font6x14.h"
 
+// built-in font descriptors
+const ssd1306_font_t ssd1306_font5x7 =
+		{&font5x7[0], &font5x7_map_cp[0], &font5x7_map_glyph[0], 0, 128, sizeof font5x7_map_cp / sizeof font5x7_map_cp[0], '?', 5, 1};
+const ssd1306_font_t ssd1306_font6x14 =
+		{&font6x14[0], NULL, NULL, 0, 128, 0, '?', 6, 2};
+
 // display buffer array
 uint8_t display_buffer[(SSD1306_OLED_HEIGHT_MAX / 8)] [SSD1306_OLED_WIDTH_MAX] = {{0}};
 
-// array of default initialization commands
+#ifdef SSD1306_GLYPH_CACHE
+#define SSD1306_GLYPH_CACHE_SLOTS (SSD1306_GLYPH_CACHE_BYTES / SSD1306_GLYPH_CACHE_SLOT)
+#if SSD1306_GLYPH_CACHE_SLOTS < 1
+	#error "SSD1306_GLYPH_CACHE_BYTES smaller than SSD1306_GLYPH_CACHE_SLOT"
+#endif
+
+// glyph cache slots, keyed by flash glyph address and y shift, free while glyph is NULL
+static const uint8_t *glyph_cache_glyph[SSD1306_GLYPH_CACHE_SLOTS];
+static uint8_t        glyph_cache_shift[SSD1306_GLYPH_CACHE_SLOTS];
+static uint16_t       glyph_cache_used[SSD1306_GLYPH_CACHE_SLOTS];
+static uint8_t        glyph_cache_data[SSD1306_GLYPH_CACHE_SLOTS][SSD1306_GLYPH_CACHE_SLOT];
+static uint16_t       glyph_cache_time;
+static uint16_t       glyph_cache_hits;
+static uint16_t       glyph_cache_misses;
+#endif
+
+// array of default initialization commands (geometry commands sent separately)
 const uint8_t PROGMEM cmd_tx[] = 
 		{
 		SSD1306_DISPLAYOFF,
 		SSD1306_SETDISPLAYCLOCKDIV, 0x80,
-		SSD1306_SETMULTIPLEX, (SSD1306_OLED_HEIGHT_MAX - 1),
 		SSD1306_SETDISPLAYOFFSET, 0x00,
 		SSD1306_SETSTARTLINE | 0x00,
 		SSD1306_CHARGEPUMP, SSD1306_CHARGE_PUMP_ENABLE,
 		SSD1306_MEMORYMODE, SSD1306_MODE_HORIZONTAL,
 		SSD1306_SEGREMAP | 0x01,
 		SSD1306_COMSCANDEC,
-		SSD1306_SETCOMPINS, SSD1306_COMPINS_ALT | SSD1306_COMPINS_DIS,
 		SSD1306_SETCONTRAST, 0xCF,
 		SSD1306_SETPRECHARGE, 0xF1,
 		SSD1306_SETVCOMDETECT, 0x40,
@@ -46,25 +82,92 @@ const uint8_t PROGMEM cmd_tx[] =
 		SSD1306_NORMALDISPLAY,
 //		SSD1306_INVERTDISPLAY,
 		SSD1306_DEACTIVATE_SCROLL,
-//		SSD1306_COLUMNADDR, 0x00, SSD1306_COL_MAX,
-//		SSD1306_PAGEADDR,   0x00, SSD1306_PAGE_MAX,
 		SSD1306_SETLOWCOLUMN,
 		SSD1306_SETHIGHCOLUMN,
 		SSD1306_SETPAGESTART | 0x00,
-		SSD1306_DISPLAYON,
+		};
+
+// array of warm start commands (address window sent separately)
+const uint8_t PROGMEM cmd_warm_tx[] = 
+		{
+		SSD1306_DEACTIVATE_SCROLL,
+		SSD1306_MEMORYMODE, SSD1306_MODE_HORIZONTAL,
+		SSD1306_SETSTARTLINE | 0x00,
+		};
+
+// flash send chunk size
+#define SSD1306_SEND_P_CHUNK 16
+
+// column-major gather chunk size for vertical addressing
+#define SSD1306_VERTICAL_CHUNK 32
+
+// per transfer overhead in bytes (address, control byte, start/stop), used to pick addressing mode
+#define SSD1306_I2C_TRANSFER_COST 3
+#define SSD1306_SPI_TRANSFER_COST 1
+
+// nibble bit spreading for scaled text, each bit repeated 2, 3 or 4 times
+const uint8_t PROGMEM spread2_tx[] =
+		{
+		0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+		};
+const uint16_t PROGMEM spread3_tx[] =
+		{
+		0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+		0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF,
+		};
+const uint16_t PROGMEM spread4_tx[] =
+		{
+		0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+		0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF,
 		};
 
 
+#ifdef SSD1306_WIRE_LOG
 //----------------------------------------------------------------------------------------------------
-// send to display
+// i2c address of device in wire log, 00 on spi
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_send(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
+static uint8_t ssd1306_wire_log_addr(ssd1306_t *dev)
 	{
-	// check for valid device
-	if (dev->valid_flag != DEV_VALID)
-		return -1;
+	return (SSD1306_DEV_BUS(dev) == SSD1306_BUS_I2C) ? SSD1306_DEV_ADDR(dev) : 0x00;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// log transfer to stdio for host-side emulation (tools/ssd1306_emu.py)
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_wire_log(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
+	{
+	putchar((dc_flag == SSD1306_DC_DATA) ? 'D' : 'C');
+	printf(" %02X", ssd1306_wire_log_addr(dev));
+	for (size_t i = 0; i < size; i++)
+		printf(" %02X", data[i]);
+	putchar('\n');
+	}
+
+//----------------------------------------------------------------------------------------------------
+// log display buffer to stdio for comparison with emulated display memory
+//----------------------------------------------------------------------------------------------------
+void ssd1306_wire_log_buffer(ssd1306_t *dev)
+	{
+	for (uint8_t i = 0; i <= SSD1306_DEV_PAGE_MAX(dev); i++)
+		{
+		printf("B %02X %u", ssd1306_wire_log_addr(dev), i);
+		for (uint8_t j = 0; j <= SSD1306_DEV_SEG_MAX(dev); j++)
+			printf(" %02X", SSD1306_BUFFER(dev, i, j));
+		putchar('\n');
+		}
+	}
+
+#endif
 
-	switch (dev->bus_type)
+//----------------------------------------------------------------------------------------------------
+// single transfer on device bus
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_send_bus(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
+	{
+	// unused when bus and address are configured constants
+	(void)dev;
+
+	switch (SSD1306_DEV_BUS(dev))
 		{
 #ifdef SSD1306_I2C
 		case SSD1306_BUS_I2C:
@@ -76,9 +179,14 @@ int8_t ssd1306_send(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
 			else
 				dc_byte = 0x00;
 
-			// send via i2c bus
-			i2c_master_write(dev->i2c_addr, &dc_byte, 1, I2C_SEQ_START); // send D/C byte
-			i2c_master_write(dev->i2c_addr, data, size, I2C_SEQ_STOP);   // send data bytes
+			// send via i2c bus, release bus when address or D/C byte fails
+			if (i2c_master_write(SSD1306_DEV_ADDR(dev), &dc_byte, 1, I2C_SEQ_START)) // send D/C byte
+				{
+				i2c_master_write(SSD1306_DEV_ADDR(dev), NULL, 0, I2C_SEQ_STOP);
+				return -1;
+				}
+			if (i2c_master_write(SSD1306_DEV_ADDR(dev), data, size, I2C_SEQ_STOP))   // send data bytes
+				return SSD1306_SEND_PARTIAL;
 			break;
 			}
 #endif
@@ -95,7 +203,8 @@ int8_t ssd1306_send(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
 				pin_state_set(&dev->dc_pin, PIN_OUT_LOW);                          // command - clear D/C pin
 
 			// send via spi bus
-			spi_write(data, size);
+			if (spi_write(data, size))
+				return SSD1306_SEND_PARTIAL;
 			break;
 			}
 #endif
@@ -108,13 +217,146 @@ int8_t ssd1306_send(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
 	}
 
 //----------------------------------------------------------------------------------------------------
-// initialize display
+// send to display
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_init(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus, uint8_t addr, uint8_t reset_pin, uint8_t dc_pin)
+int8_t ssd1306_send(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// any transfer moves the display address, flush job and window owner set their window again
+	dev->flush_window = SSD1306_FLUSH_WIN_NONE;
+	dev->window_owner = NULL;
+
+	// fail fast while bus is held off after an error
+	if (dev->bus_offline)
+		{
+		if ((uint16_t)(dev->tick() - dev->bus_fail_tick) < dev->bus_holdoff_ms)
+			return -1;
+		dev->bus_offline = 0;
+		}
+
+	uint16_t start_tick = 0;
+	if (dev->tick != NULL)
+		start_tick = dev->tick();
+
+	for (uint8_t attempt = 0; ; attempt++)
+		{
+		int8_t result = ssd1306_send_bus(dev, data, size, dc_flag);
+
+		// check time budget
+		uint8_t timed_out = 0;
+		if ((dev->tick != NULL) && (dev->bus_timeout_ms != 0))
+			if ((uint16_t)(dev->tick() - start_tick) > dev->bus_timeout_ms)
+				timed_out = 1;
+
+		if (result == 0)
+			{
+#ifdef SSD1306_WIRE_LOG
+			ssd1306_wire_log(dev, data, size, dc_flag);
+#endif
+			dev->stats.bytes += (uint32_t)size;
+			if (timed_out)
+				dev->stats.timeouts++;
+			return 0;
+			}
+		dev->stats.naks++;
+
+		// controller took part of the data, resending would land shifted
+		if (result == SSD1306_SEND_PARTIAL)
+			return SSD1306_SEND_PARTIAL;
+
+		// give up after retries or when out of time
+		if (timed_out)
+			dev->stats.timeouts++;
+		if (timed_out || (attempt >= dev->bus_retries))
+			break;
+		dev->stats.retries++;
+		}
+
+	// hold off further transfers so callers keep their timing
+	if ((dev->tick != NULL) && (dev->bus_holdoff_ms != 0))
+		{
+		dev->bus_offline   = 1;
+		dev->bus_fail_tick = dev->tick();
+		}
+
+	return -1;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// configure bus error handling
+// (a transfer blocked inside the bus driver can only be bounded by the driver itself)
+//----------------------------------------------------------------------------------------------------
+void ssd1306_bus_config(ssd1306_t *dev, uint8_t retries, uint16_t timeout_ms, uint16_t holdoff_ms, ssd1306_tick_t tick)
+	{
+	dev->bus_retries    = retries;
+	dev->bus_timeout_ms = timeout_ms;
+	dev->bus_holdoff_ms = holdoff_ms;
+	dev->bus_offline    = 0;
+	dev->tick           = tick;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear bus statistics
+//----------------------------------------------------------------------------------------------------
+void ssd1306_stats_clear(ssd1306_t *dev)
+	{
+	memset(&dev->stats, 0x00, sizeof dev->stats);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send from flash to display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_send_P(ssd1306_t *dev, const uint8_t *data, size_t size, uint8_t dc_flag)
+	{
+	uint8_t work[SSD1306_SEND_P_CHUNK];
+
+	// stream through a small buffer instead of copying the whole block
+	while (size)
+		{
+		size_t chunk = (size > sizeof work) ? sizeof work : size;
+		memcpy_P(&work[0], data, chunk);
+		if (ssd1306_send(dev, &work[0], chunk, dc_flag))
+			return -1;
+
+		data += chunk;
+		size -= chunk;
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// validate and save device configuration
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_dev_setup(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus, uint8_t addr, uint8_t reset_pin, uint8_t dc_pin)
 	{
 	// set device to invalid
 	dev->valid_flag = DEV_INVALID;
 
+	// default bus error handling, no retries or timeouts
+	ssd1306_bus_config(dev, 0, 0, 0, NULL);
+	ssd1306_stats_clear(dev);
+	ssd1306_dirty_clear(dev);
+
+	// plain drawing
+	dev->rop = SSD1306_ROP_COPY;
+
+	// no flush job
+	dev->flush_state      = SSD1306_FLUSH_IDLE;
+	dev->flush_window     = SSD1306_FLUSH_WIN_NONE;
+	dev->flush_next_valid = 0;
+	dev->window_owner     = NULL;
+
+	// display calls sent right away
+	dev->frame_active = 0;
+	dev->frame_count  = 0;
+
+	// draw into shared display buffer
+	ssd1306_buffer_set(dev, &display_buffer[0][0], SSD1306_OLED_WIDTH_MAX);
+
 	// validate bus type
 	if ((bus != SSD1306_BUS_I2C) && (bus != SSD1306_BUS_SPI))
 		return -1;
@@ -131,15 +373,41 @@ int8_t ssd1306_init(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus,
 	// validate and save size info
 	if ((height > SSD1306_OLED_HEIGHT_MAX) || (width > SSD1306_OLED_WIDTH_MAX))
 		return -1;
+	if ((height < 8) || (height % 8) || (width == 0))
+		return -1;
 	dev->oled_height   = height;
 	dev->oled_width    = width;
 	dev->oled_seg_max  = (uint8_t)(dev->oled_width - 1);
 	dev->oled_page_max = (uint8_t)((dev->oled_height / 8) - 1);
 
+#ifdef SSD1306_CONFIG
+	// arguments must match compile-time configuration
+	if ((bus != SSD1306_DEV_BUS(dev)) || (width != SSD1306_DEV_WIDTH(dev)) || (height != SSD1306_DEV_HEIGHT(dev)))
+		return -1;
+	if ((bus == SSD1306_BUS_I2C) && (addr != SSD1306_DEV_ADDR(dev)))
+		return -1;
+#endif
+
 	// intialize reset and D/C pins
 	pin_init_ard(&dev->reset_pin, reset_pin);
 	pin_init_ard(&dev->dc_pin, dc_pin);
 
+	// D/C pin required for spi device
+	if (dev->bus_type == SSD1306_BUS_SPI && dev->dc_pin.valid_flag != PIN_VALID)
+			return -1;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_init(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus, uint8_t addr, uint8_t reset_pin, uint8_t dc_pin)
+	{
+	// validate and save configuration
+	if (ssd1306_dev_setup(dev, width, height, bus, addr, reset_pin, dc_pin))
+		return -1;
+
 	// reset ssd1306
 	if (dev->reset_pin.valid_flag == PIN_VALID)
 		{
@@ -149,207 +417,1271 @@ int8_t ssd1306_init(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus,
 		pin_state_set(&dev->reset_pin, PIN_OUT_HIGH);
 		}
 
-	// D/C pin required for spi device
-	if (dev->bus_type == SSD1306_BUS_SPI && dev->dc_pin.valid_flag != PIN_VALID)
-			return -1;
-
 	// set device to valid
 	dev->valid_flag = DEV_VALID;
 
-	// copy command list from flash 
-	uint8_t cmd_array[sizeof cmd_tx];
-	memcpy_P(&cmd_array[0], &cmd_tx[0], sizeof cmd_array);
+	// stream initialize commands from flash
+	if (ssd1306_send_P(dev, &cmd_tx[0], sizeof cmd_tx, SSD1306_DC_CMD))
+		return -1;
+	dev->addr_mode = SSD1306_MODE_HORIZONTAL;
 
-	// send initialize commands to display
-	if (ssd1306_send(dev, &cmd_array[0], sizeof cmd_array, SSD1306_DC_CMD))
+	// send geometry commands, 32 line panels use sequential COM pins
+	uint8_t com_pins = (height > SSD1306_OLED_HEIGHT_32) ? SSD1306_COMPINS_ALT : SSD1306_COMPINS_SEQ;
+	uint8_t ssd_cmd[] =
+		{
+		SSD1306_SETMULTIPLEX, (uint8_t)(height - 1),
+		SSD1306_SETCOMPINS, (uint8_t)(com_pins | SSD1306_COMPINS_DIS),
+		SSD1306_DISPLAYON,
+		};
+	if (ssd1306_send(dev, &ssd_cmd[0], sizeof ssd_cmd, SSD1306_DC_CMD))
 		return -1;
 
 	return 0;
 	}
 
 //----------------------------------------------------------------------------------------------------
-// send buffer to display
+// re-attach to a display that kept its configuration (e.g. after an mcu watchdog reset)
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_display(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
+int8_t ssd1306_init_warm(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus, uint8_t addr, uint8_t reset_pin, uint8_t dc_pin)
 	{
-	// check for valid device
-	if (dev->valid_flag != DEV_VALID)
+	// validate and save configuration, no reset pulse
+	if (ssd1306_dev_setup(dev, width, height, bus, addr, reset_pin, dc_pin))
 		return -1;
 
-	// check limits
-	if (start_seg  > dev->oled_seg_max ) return -1;
-	if (end_seg    > dev->oled_seg_max ) end_seg  = dev->oled_seg_max;
-	if (start_page > dev->oled_page_max) return -1;
-	if (end_page   > dev->oled_page_max) end_page = dev->oled_page_max;
+	// set device to valid
+	dev->valid_flag = DEV_VALID;
 
-	// set up display area
-	uint8_t ssd_cmd[] = {SSD1306_PAGEADDR, start_page, end_page, SSD1306_COLUMNADDR, start_seg, end_seg};
-	if (ssd1306_send(dev, &ssd_cmd[0], sizeof ssd_cmd, SSD1306_DC_CMD))
+	// restore addressing mode and window
+	if (ssd1306_send_P(dev, &cmd_warm_tx[0], sizeof cmd_warm_tx, SSD1306_DC_CMD))
+		return -1;
+	dev->addr_mode = SSD1306_MODE_HORIZONTAL;
+	if (ssd1306_window(dev, 0, SSD1306_DEV_PAGE_MAX(dev), 0, SSD1306_DEV_SEG_MAX(dev)))
 		return -1;
-
-	// send data to display
-	size_t  size = (size_t)((end_seg - start_seg) + 1);
-	for (uint8_t i = start_page; i <= end_page; i++)
-		if (ssd1306_send(dev, &display_buffer[i][start_seg], size, SSD1306_DC_DATA))
-			return -1;
 
 	return 0;
 	}
 
 //----------------------------------------------------------------------------------------------------
-// clear entire buffer
+// set display area for following data
 //----------------------------------------------------------------------------------------------------
-void ssd1306_clear_buffer(void)
+int8_t ssd1306_window(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
 	{
-	// clear display
-	memset(&display_buffer[0][0], 0x00, sizeof display_buffer);
+	return ssd1306_window_mode(dev, SSD1306_MODE_HORIZONTAL, start_page, end_page, start_seg, end_seg);
 	}
 
 //----------------------------------------------------------------------------------------------------
-// set pixel at x,y
+// set addressing mode (horizontal or vertical) and display area for following data
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_pixel_set(ssd1306_t *dev, uint8_t pixel_x, uint8_t pixel_y, uint8_t pixel_value)
+int8_t ssd1306_window_mode(ssd1306_t *dev, uint8_t mode, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
 	{
-	// check for valid device
-	if (dev->valid_flag != DEV_VALID)
-		return -1;
-
-	// check limits
-	if ((pixel_x > dev->oled_width) || (pixel_y > dev->oled_height))
-		return -1;
-
-	// determine display page and create bit mask
-	uint8_t pixel_page = pixel_y / 8;
-	uint8_t pixel_pos  = pixel_y % 8;
-	uint8_t pixel_bit  = (uint8_t)(1 << pixel_pos);
+	uint8_t ssd_cmd[] = {SSD1306_MEMORYMODE, mode, SSD1306_PAGEADDR, start_page, end_page, SSD1306_COLUMNADDR, start_seg, end_seg};
 
-	// set bit on or off
-	if (pixel_value)
-		display_buffer[pixel_page][pixel_x] |= pixel_bit;
-	else
-		display_buffer[pixel_page][pixel_x] &= (uint8_t)~pixel_bit;
+	// mode command only when it changes, unknown after a failed transfer
+	uint8_t skip = (dev->addr_mode == mode) ? 2 : 0;
+	int8_t  result = ssd1306_send(dev, &ssd_cmd[skip], sizeof ssd_cmd - skip, SSD1306_DC_CMD);
+	if (result)
+		{
+		dev->addr_mode = SSD1306_MODE_UNKNOWN;
+		return result;
+		}
+	dev->addr_mode = mode;
 
 	return 0;
 	}
 
 //----------------------------------------------------------------------------------------------------
-// set pixels in an area
+// check if vertical addressing needs fewer transfer overhead bytes than one transfer per page
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_area_set(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y, uint8_t pixel_value)
+static uint8_t ssd1306_vertical_cheaper(ssd1306_t *dev, uint8_t page_count, uint8_t seg_count)
 	{
-	// check for valid device
-	if (dev->valid_flag != DEV_VALID)
-		return -1;
+	if (page_count < 2)
+		return 0;
 
-	// check limits
-	if (start_x > dev->oled_width-1)  return -1;
-	if (end_x   > dev->oled_width-1)  end_x   = (uint8_t)(dev->oled_width-1);
-	if (start_y > dev->oled_height-1) return -1;
-	if (end_y   > dev->oled_height-1) end_y   = (uint8_t)(dev->oled_height-1);
+	uint16_t cost = (SSD1306_DEV_BUS(dev) == SSD1306_BUS_I2C) ? SSD1306_I2C_TRANSFER_COST : SSD1306_SPI_TRANSFER_COST;
+	uint16_t size = (uint16_t)(page_count * seg_count);
 
-	// set pixels
-	for (uint8_t y = start_y; y <= end_y; y++)
-		for (uint8_t x = start_x; x <= end_x; x++)
-			if (ssd1306_pixel_set(dev, x, y, pixel_value))
-				return -1;
+	// same data bytes either way, vertical adds mode commands there and back unless already vertical
+	uint16_t horizontal = (uint16_t)(page_count * cost);
+	uint16_t vertical   = (uint16_t)(((size + SSD1306_VERTICAL_CHUNK - 1) / SSD1306_VERTICAL_CHUNK) * cost);
+	if (dev->addr_mode != SSD1306_MODE_VERTICAL)
+		vertical = (uint16_t)(vertical + 4);
 
-	return 0;
+	return vertical < horizontal;
 	}
 
 //----------------------------------------------------------------------------------------------------
-// map bitmap into display buffer
+// send buffer area column by column in vertical addressing mode
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_bitmap(ssd1306_t *dev, uint8_t *bitmap, uint8_t *bitmap_mask,
-		uint8_t bitmap_seg_size, uint8_t bitmap_page_size, uint8_t start_pixel_x, uint8_t start_pixel_y)
+static int8_t ssd1306_display_vertical(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
 	{
-	// check for valid device
-	if (dev->valid_flag != DEV_VALID)
-		return -1;
+	int8_t result = ssd1306_window_mode(dev, SSD1306_MODE_VERTICAL, start_page, end_page, start_seg, end_seg);
+	if (result)
+		return result;
 
-	// loop through bitmap bytes
-	for (uint8_t x = 0; x < bitmap_seg_size; x++)
+	// gather columns into chunks, data continues across transfers
+	uint8_t work[SSD1306_VERTICAL_CHUNK];
+	uint8_t count = 0;
+	for (uint8_t j = start_seg; j <= end_seg; j++)
 		{
-		// calculate x-position
-		uint8_t x_pos = (uint8_t)(start_pixel_x + x);
-		if (x_pos > (uint8_t)(dev->oled_width-1))
-			break;
-
-		// loop through bitmap pages
-		for (uint8_t i = 0; i < bitmap_page_size; i++)
+		for (uint8_t i = start_page; i <= end_page; i++)
 			{
-			// get bitmap and bitmap_mask bytes
-			uint8_t bitmap_byte      = bitmap[x + (i*bitmap_seg_size)];
-			uint8_t bitmap_mask_byte = 0xFF;
-			if (bitmap_mask != NULL)
-				bitmap_mask_byte = bitmap_mask[x + (i*bitmap_seg_size)];
-
-			// loop through bits
-			for (uint8_t y = 0; y < 8; y++)
+			work[count++] = SSD1306_BUFFER(dev, i, j);
+			if (count == sizeof work)
 				{
-				// calculate y-position of bit
-				uint8_t y_pos = (uint8_t)(start_pixel_y + y + (i*8));
-				if (y_pos > dev->oled_height-1)
-					break;
-
-				// if mask bit set, set pixel from bit
-				if ((bitmap_mask_byte & (1 << y)))
-					if (ssd1306_pixel_set(dev, x_pos, y_pos, (uint8_t)(bitmap_byte & (1 << y))))
-						return -1;
+				result = ssd1306_send(dev, &work[0], count, SSD1306_DC_DATA);
+				if (result)
+					return result;
+				count = 0;
 				}
 			}
 		}
+	if (count)
+		return ssd1306_send(dev, &work[0], count, SSD1306_DC_DATA);
 
 	return 0;
 	}
 
 //----------------------------------------------------------------------------------------------------
-// map text into display buffer
+// estimate bus bytes ssd1306_display() needs for an area, window command and transfer overhead included
 //----------------------------------------------------------------------------------------------------
-int8_t ssd1306_text(ssd1306_t *dev, char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t font)
+static uint16_t ssd1306_area_cost(ssd1306_t *dev, const uint8_t *area)
 	{
-	// check for valid device
-	if (dev->valid_flag != DEV_VALID)
-		return -1;
+	uint8_t  page_count = (uint8_t)((area[1] - area[0]) + 1);
+	uint8_t  seg_count  = (uint8_t)((area[3] - area[2]) + 1);
+	uint16_t cost       = (SSD1306_DEV_BUS(dev) == SSD1306_BUS_I2C) ? SSD1306_I2C_TRANSFER_COST : SSD1306_SPI_TRANSFER_COST;
+	uint16_t size       = (uint16_t)(page_count * seg_count);
 
-	const uint8_t *font_ptr;
-	uint8_t font_bytes;
-	uint8_t font_segs;
-	uint8_t font_pages;
+	// one transfer per page, one for full buffer rows, one per chunk in vertical mode
+	uint16_t overhead = (uint16_t)(page_count * cost);
+	if (seg_count == dev->buffer_stride)
+		overhead = cost;
+	else if (ssd1306_vertical_cheaper(dev, page_count, seg_count))
+		overhead = (uint16_t)((((size + SSD1306_VERTICAL_CHUNK - 1) / SSD1306_VERTICAL_CHUNK) * cost) + 4);
 
-	// set up font values
-	if (font == SSD1306_FONT_6X14)
-		{
-		font_ptr   = &font6x14[0];
-		font_bytes = 12;
-		font_segs  = 6;
-		font_pages = 2;
-		}
-	else
-		{
-		font_ptr   = &font5x7[0];
-		font_bytes = 5;
-		font_segs  = 5;
-		font_pages = 1;
-		}
+	return (uint16_t)(size + overhead + 6 + cost);
+	}
 
-	// loop through string characters
-	for (char *character = text; (*character != '\0'); character++)
-		{
-		// get character font bytes from flash
-		int font_index = (int)((*character) * font_bytes);
-		uint8_t work[font_bytes];
-		memcpy_P(&work[0], &font_ptr[font_index], font_bytes);
+//----------------------------------------------------------------------------------------------------
+// bounding area of two areas
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_area_union(uint8_t *area, const uint8_t *a, const uint8_t *b)
+	{
+	area[0] = (a[0] < b[0]) ? a[0] : b[0];
+	area[1] = (a[1] > b[1]) ? a[1] : b[1];
+	area[2] = (a[2] < b[2]) ? a[2] : b[2];
+	area[3] = (a[3] > b[3]) ? a[3] : b[3];
+	}
 
-		// bitmap font into buffer
-		if (ssd1306_bitmap(dev, &work[0], &work[0], font_segs, font_pages, start_pixel_x, start_pixel_y))
-			return -1;
+//----------------------------------------------------------------------------------------------------
+// check if area a lies inside area b
+//----------------------------------------------------------------------------------------------------
+static uint8_t ssd1306_area_inside(const uint8_t *a, const uint8_t *b)
+	{
+	return (a[0] >= b[0]) && (a[1] <= b[1]) && (a[2] >= b[2]) && (a[3] <= b[3]);
+	}
 
-		// increment to next character display position
-		start_pixel_x = (uint8_t)(start_pixel_x + font_segs);
-		if (start_pixel_x > (uint8_t)(dev->oled_width-1))
-			break;
-		}
+//----------------------------------------------------------------------------------------------------
+// add area to frame, dropping recorded areas it covers
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_frame_insert(ssd1306_t *dev, const uint8_t *area)
+	{
+	uint8_t j = 0;
+	for (uint8_t i = 0; i < dev->frame_count; i++)
+		if (!ssd1306_area_inside(&dev->frame_area[i][0], area))
+			memcpy(&dev->frame_area[j++][0], &dev->frame_area[i][0], 4);
+	memcpy(&dev->frame_area[j++][0], area, 4);
+	dev->frame_count = j;
+	}
 
-	return 0;
+//----------------------------------------------------------------------------------------------------
+// merge the pair of recorded areas saving most bus bytes, return 1 if saving reached min_saved
+//----------------------------------------------------------------------------------------------------
+static uint8_t ssd1306_frame_merge(ssd1306_t *dev, int16_t min_saved)
+	{
+	uint8_t best_i     = 0;
+	uint8_t best_j     = 0;
+	int16_t best_saved = INT16_MIN;
+	for (uint8_t i = 0; i < dev->frame_count; i++)
+		for (uint8_t j = (uint8_t)(i + 1); j < dev->frame_count; j++)
+			{
+			uint8_t merged[4];
+			ssd1306_area_union(&merged[0], &dev->frame_area[i][0], &dev->frame_area[j][0]);
+			int16_t saved = (int16_t)(ssd1306_area_cost(dev, &dev->frame_area[i][0]) +
+					ssd1306_area_cost(dev, &dev->frame_area[j][0]) - ssd1306_area_cost(dev, &merged[0]));
+			if (saved > best_saved)
+				{
+				best_i     = i;
+				best_j     = j;
+				best_saved = saved;
+				}
+			}
+	if ((dev->frame_count < 2) || (best_saved < min_saved))
+		return 0;
+
+	// merged area replaces both and every area it covers
+	uint8_t merged[4];
+	ssd1306_area_union(&merged[0], &dev->frame_area[best_i][0], &dev->frame_area[best_j][0]);
+	ssd1306_frame_insert(dev, &merged[0]);
+
+	return 1;
 	}
 
+//----------------------------------------------------------------------------------------------------
+// record display area of frame, merging the cheapest pair first when full
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_frame_add(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
+	{
+	uint8_t area[4] = {start_page, end_page, start_seg, end_seg};
+
+	// already covered
+	for (uint8_t i = 0; i < dev->frame_count; i++)
+		if (ssd1306_area_inside(&area[0], &dev->frame_area[i][0]))
+			return 0;
+
+	if (dev->frame_count == SSD1306_FRAME_AREAS_MAX)
+		ssd1306_frame_merge(dev, INT16_MIN);
+
+	ssd1306_frame_insert(dev, &area[0]);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// start recording display calls, sent merged by ssd1306_frame_commit()
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_frame_begin(ssd1306_t *dev)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// frames do not nest
+	if (dev->frame_active)
+		return -1;
+
+	dev->frame_active = 1;
+	dev->frame_count  = 0;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// merge recorded areas where one window costs less than two and send them
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_frame_commit(ssd1306_t *dev)
+	{
+	if (!dev->frame_active)
+		return -1;
+	dev->frame_active = 0;
+
+	// merge while one window costs no more than two
+	while (ssd1306_frame_merge(dev, 0))
+		;
+
+	for (uint8_t i = 0; i < dev->frame_count; i++)
+		if (ssd1306_display(dev, dev->frame_area[i][0], dev->frame_area[i][1], dev->frame_area[i][2], dev->frame_area[i][3]))
+			return -1;
+	dev->frame_count = 0;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send buffer area, SSD1306_SEND_PARTIAL when a transfer was cut off
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_display_area(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
+	{
+	// tall narrow areas stream column by column
+	if ((end_seg - start_seg + 1 != dev->buffer_stride) &&
+			ssd1306_vertical_cheaper(dev, (uint8_t)((end_page - start_page) + 1), (uint8_t)((end_seg - start_seg) + 1)))
+		return ssd1306_display_vertical(dev, start_page, end_page, start_seg, end_seg);
+
+	// set up display area
+	int8_t result = ssd1306_window(dev, start_page, end_page, start_seg, end_seg);
+	if (result)
+		return result;
+
+	// full buffer rows are contiguous, stream them in one transfer
+	size_t  size = (size_t)((end_seg - start_seg) + 1);
+	if (size == dev->buffer_stride)
+		return ssd1306_send(dev, &SSD1306_BUFFER(dev, start_page, 0), size * (size_t)((end_page - start_page) + 1), SSD1306_DC_DATA);
+
+	// send data to display
+	for (uint8_t i = start_page; i <= end_page; i++)
+		{
+		result = ssd1306_send(dev, &SSD1306_BUFFER(dev, i, start_seg), size, SSD1306_DC_DATA);
+		if (result)
+			return result;
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send buffer to display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_display(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// check limits
+	if (start_seg  > SSD1306_DEV_SEG_MAX(dev))  return -1;
+	if (end_seg    > SSD1306_DEV_SEG_MAX(dev))  end_seg  = SSD1306_DEV_SEG_MAX(dev);
+	if (start_page > SSD1306_DEV_PAGE_MAX(dev)) return -1;
+	if (end_page   > SSD1306_DEV_PAGE_MAX(dev)) end_page = SSD1306_DEV_PAGE_MAX(dev);
+
+	// inside frame, record area and send at commit
+	if (dev->frame_active)
+		return ssd1306_frame_add(dev, start_page, end_page, start_seg, end_seg);
+
+	// data cut off mid transfer, set window again and resend whole area
+	for (uint8_t attempt = 0; ; attempt++)
+		{
+		int8_t result = ssd1306_display_area(dev, start_page, end_page, start_seg, end_seg);
+		if (result == 0)
+			return 0;
+		if ((result != SSD1306_SEND_PARTIAL) || (attempt >= dev->bus_retries))
+			return -1;
+		dev->stats.retries++;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set buffer the device draws into and displays from, stride is bytes per page
+//----------------------------------------------------------------------------------------------------
+void ssd1306_buffer_set(ssd1306_t *dev, uint8_t *buffer, uint16_t stride)
+	{
+	dev->buffer        = buffer;
+	dev->buffer_stride = stride;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// mark buffer area as changed
+//----------------------------------------------------------------------------------------------------
+void ssd1306_dirty_mark(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y)
+	{
+	// check limits
+	if (start_x > SSD1306_DEV_WIDTH(dev)-1)  return;
+	if (end_x   > SSD1306_DEV_WIDTH(dev)-1)  end_x   = (uint8_t)(SSD1306_DEV_WIDTH(dev)-1);
+	if (start_y > SSD1306_DEV_HEIGHT(dev)-1) return;
+	if (end_y   > SSD1306_DEV_HEIGHT(dev)-1) end_y   = (uint8_t)(SSD1306_DEV_HEIGHT(dev)-1);
+
+	// extend dirty span of each page
+	for (uint8_t i = start_y / 8; i <= end_y / 8; i++)
+		{
+		if (start_x < dev->dirty_seg_lo[i]) dev->dirty_seg_lo[i] = start_x;
+		if (end_x   > dev->dirty_seg_hi[i]) dev->dirty_seg_hi[i] = end_x;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// mark whole buffer as unchanged
+//----------------------------------------------------------------------------------------------------
+void ssd1306_dirty_clear(ssd1306_t *dev)
+	{
+	memset(&dev->dirty_seg_lo[0], 0xFF, sizeof dev->dirty_seg_lo);
+	memset(&dev->dirty_seg_hi[0], 0x00, sizeof dev->dirty_seg_hi);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send changed buffer areas to display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_display_dirty(ssd1306_t *dev)
+	{
+	for (uint8_t i = 0; i <= SSD1306_DEV_PAGE_MAX(dev); i++)
+		{
+		// skip clean pages
+		uint8_t start_seg = dev->dirty_seg_lo[i];
+		uint8_t end_seg   = dev->dirty_seg_hi[i];
+		if (start_seg > end_seg)
+			continue;
+
+		// following pages with the same span share one window
+		uint8_t end_page = i;
+		while ((end_page < SSD1306_DEV_PAGE_MAX(dev)) &&
+				(dev->dirty_seg_lo[end_page+1] == start_seg) && (dev->dirty_seg_hi[end_page+1] == end_seg))
+			end_page++;
+
+		if (ssd1306_display(dev, i, end_page, start_seg, end_seg))
+			return -1;
+		i = end_page;
+		}
+
+	ssd1306_dirty_clear(dev);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// start flush job of buffer area, merged into the next job when one is running (returns 1)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_flush_start(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// check limits
+	if (start_seg  > SSD1306_DEV_SEG_MAX(dev))  return -1;
+	if (end_seg    > SSD1306_DEV_SEG_MAX(dev))  end_seg  = SSD1306_DEV_SEG_MAX(dev);
+	if (start_page > SSD1306_DEV_PAGE_MAX(dev)) return -1;
+	if (end_page   > SSD1306_DEV_PAGE_MAX(dev)) end_page = SSD1306_DEV_PAGE_MAX(dev);
+	if ((start_page > end_page) || (start_seg > end_seg))
+		return -1;
+
+	// frame requested before the last one finished, merge with other waiting frames
+	if (dev->flush_state == SSD1306_FLUSH_BUSY)
+		{
+		uint8_t *next = &dev->flush_next[0];
+		if (!dev->flush_next_valid)
+			{
+			next[0] = start_page;
+			next[1] = end_page;
+			next[2] = start_seg;
+			next[3] = end_seg;
+			dev->flush_next_valid = 1;
+			}
+		else
+			{
+			if (start_page < next[0]) next[0] = start_page;
+			if (end_page   > next[1]) next[1] = end_page;
+			if (start_seg  < next[2]) next[2] = start_seg;
+			if (end_seg    > next[3]) next[3] = end_seg;
+			}
+		return 1;
+		}
+
+	dev->flush_area[0] = start_page;
+	dev->flush_area[1] = end_page;
+	dev->flush_area[2] = start_seg;
+	dev->flush_area[3] = end_seg;
+	dev->flush_page    = start_page;
+	dev->flush_seg     = start_seg;
+	dev->flush_window  = SSD1306_FLUSH_WIN_NONE;
+	dev->flush_state   = SSD1306_FLUSH_BUSY;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// start flush job of changed buffer area
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_flush_dirty(ssd1306_t *dev)
+	{
+	// bounding area of dirty spans
+	uint8_t start_page = 0xFF;
+	uint8_t end_page   = 0;
+	uint8_t start_seg  = 0xFF;
+	uint8_t end_seg    = 0;
+	for (uint8_t i = 0; i <= SSD1306_DEV_PAGE_MAX(dev); i++)
+		{
+		if (dev->dirty_seg_lo[i] > dev->dirty_seg_hi[i])
+			continue;
+		if (start_page == 0xFF)
+			start_page = i;
+		end_page = i;
+		if (dev->dirty_seg_lo[i] < start_seg) start_seg = dev->dirty_seg_lo[i];
+		if (dev->dirty_seg_hi[i] > end_seg)   end_seg   = dev->dirty_seg_hi[i];
+		}
+
+	// nothing changed
+	if (start_page == 0xFF)
+		return 0;
+
+	ssd1306_dirty_clear(dev);
+
+	return ssd1306_flush_start(dev, start_page, end_page, start_seg, end_seg);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send up to byte_budget bytes of flush job, 1 while bytes remain
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_flush_step(ssd1306_t *dev, uint16_t byte_budget)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	uint8_t  end_page  = dev->flush_area[1];
+	uint8_t  start_seg = dev->flush_area[2];
+	uint8_t  end_seg   = dev->flush_area[3];
+	uint16_t row_size  = (uint16_t)((end_seg - start_seg) + 1);
+	uint8_t  retries   = 0;
+
+	while (byte_budget && (dev->flush_state == SSD1306_FLUSH_BUSY))
+		{
+		uint8_t page = dev->flush_page;
+		uint8_t seg  = dev->flush_seg;
+
+		// set window again after other transfers, a partly sent row gets a window of its own
+		uint8_t window = dev->flush_window;
+		int8_t  result = 0;
+		if (window == SSD1306_FLUSH_WIN_NONE)
+			{
+			if (seg == start_seg)
+				{
+				window = SSD1306_FLUSH_WIN_AREA;
+				result = ssd1306_window(dev, page, end_page, start_seg, end_seg);
+				}
+			else
+				{
+				window = SSD1306_FLUSH_WIN_ROW;
+				result = ssd1306_window(dev, page, page, seg, end_seg);
+				}
+			}
+
+		// rest of row, or rest of area when rows are contiguous in buffer
+		uint16_t size = (uint16_t)((end_seg - seg) + 1);
+		if ((window == SSD1306_FLUSH_WIN_AREA) && (seg == start_seg) && (row_size == dev->buffer_stride))
+			size = (uint16_t)(row_size * (uint16_t)((end_page - page) + 1));
+		if (size > byte_budget)
+			size = byte_budget;
+
+		if (result == 0)
+			result = ssd1306_send(dev, &SSD1306_BUFFER(dev, page, seg), size, SSD1306_DC_DATA);
+
+		// transfer cut off, window is set again before the same bytes go out
+		if ((result == SSD1306_SEND_PARTIAL) && (retries < dev->bus_retries))
+			{
+			retries++;
+			dev->stats.retries++;
+			continue;
+			}
+		if (result)
+			return -1;
+		dev->flush_window = window;
+		byte_budget       = (uint16_t)(byte_budget - size);
+
+		// advance position
+		uint16_t offset = (uint16_t)((seg - start_seg) + size);
+		dev->flush_page = (uint8_t)(page + (offset / row_size));
+		dev->flush_seg  = (uint8_t)(start_seg + (offset % row_size));
+		if ((window == SSD1306_FLUSH_WIN_ROW) && (dev->flush_seg == start_seg))
+			dev->flush_window = SSD1306_FLUSH_WIN_NONE;
+
+		// job done, start merged frame
+		if (dev->flush_page > end_page)
+			{
+			dev->flush_state = SSD1306_FLUSH_IDLE;
+			if (dev->flush_next_valid)
+				{
+				dev->flush_next_valid = 0;
+				ssd1306_flush_start(dev, dev->flush_next[0], dev->flush_next[1], dev->flush_next[2], dev->flush_next[3]);
+				end_page  = dev->flush_area[1];
+				start_seg = dev->flush_area[2];
+				end_seg   = dev->flush_area[3];
+				row_size  = (uint16_t)((end_seg - start_seg) + 1);
+				}
+			}
+		}
+
+	return (dev->flush_state == SSD1306_FLUSH_BUSY) ? 1 : 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear entire buffer
+//----------------------------------------------------------------------------------------------------
+void ssd1306_clear_buffer(void)
+	{
+	// clear display
+	memset(&display_buffer[0][0], 0x00, sizeof display_buffer);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear buffer of device and mark it changed for ssd1306_display_dirty()
+//----------------------------------------------------------------------------------------------------
+void ssd1306_clear(ssd1306_t *dev)
+	{
+	// buffer rows may be wider than the device
+	for (uint8_t i = 0; i <= SSD1306_DEV_PAGE_MAX(dev); i++)
+		memset(&SSD1306_BUFFER(dev, i, 0), 0x00, SSD1306_DEV_WIDTH(dev));
+
+	ssd1306_dirty_mark(dev, 0, (uint8_t)SSD1306_DEV_SEG_MAX(dev), 0, (uint8_t)(SSD1306_DEV_HEIGHT(dev)-1));
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set raster operation of following drawing calls
+//----------------------------------------------------------------------------------------------------
+void ssd1306_rop_set(ssd1306_t *dev, uint8_t rop)
+	{
+	dev->rop = rop;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// apply raster operation to buffer byte where mask bits are set
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_rop_byte(uint8_t *byte, uint8_t bits, uint8_t mask, uint8_t rop)
+	{
+	switch (rop)
+		{
+		case SSD1306_ROP_OR:
+			*byte |= (uint8_t)(bits & mask);
+			break;
+		case SSD1306_ROP_ANDNOT:
+			*byte &= (uint8_t)~(bits & mask);
+			break;
+		case SSD1306_ROP_XOR:
+			*byte ^= (uint8_t)(bits & mask);
+			break;
+		case SSD1306_ROP_INVERT:
+			*byte ^= mask;
+			break;
+		default:
+			*byte = (uint8_t)((*byte & (uint8_t)~mask) | (bits & mask));
+			break;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// apply raster operation to bit_count column bits at x,y as whole buffer bytes
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_column_write(ssd1306_t *dev, uint8_t x, uint8_t y, uint32_t bits, uint32_t mask, uint8_t bit_count)
+	{
+	uint8_t page  = y / 8;
+	uint8_t shift = y % 8;
+
+	// first byte holds bits shifted down to y, following bytes take 8 bits each
+	uint8_t byte_bits = (uint8_t)(bits << shift);
+	uint8_t byte_mask = (uint8_t)(mask << shift);
+	bits >>= (8 - shift);
+	mask >>= (8 - shift);
+
+	uint8_t byte_count = (uint8_t)((shift + bit_count + 7) / 8);
+	for (uint8_t i = 0; i < byte_count; i++, page++)
+		{
+		if (page > SSD1306_DEV_PAGE_MAX(dev))
+			break;
+
+		ssd1306_rop_byte(&SSD1306_BUFFER(dev, page, x), byte_bits, byte_mask, dev->rop);
+
+		byte_bits = (uint8_t)bits;
+		byte_mask = (uint8_t)mask;
+		bits >>= 8;
+		mask >>= 8;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set pixel at x,y
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_pixel_set(ssd1306_t *dev, uint8_t pixel_x, uint8_t pixel_y, uint8_t pixel_value)
+	{
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	// check limits
+	if ((pixel_x > SSD1306_DEV_WIDTH(dev)-1) || (pixel_y > SSD1306_DEV_HEIGHT(dev)-1))
+		return -1;
+
+	// determine display page and create bit mask
+	uint8_t pixel_page = pixel_y / 8;
+	uint8_t pixel_pos  = pixel_y % 8;
+	uint8_t pixel_bit  = (uint8_t)(1 << pixel_pos);
+
+	// extend dirty span of page
+	if (pixel_x < dev->dirty_seg_lo[pixel_page]) dev->dirty_seg_lo[pixel_page] = pixel_x;
+	if (pixel_x > dev->dirty_seg_hi[pixel_page]) dev->dirty_seg_hi[pixel_page] = pixel_x;
+
+	// set bit on or off
+	ssd1306_rop_byte(&SSD1306_BUFFER(dev, pixel_page, pixel_x), pixel_value ? pixel_bit : 0x00, pixel_bit, dev->rop);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set batch of pixels, points outside the display are skipped
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_pixels_set(ssd1306_t *dev, const ssd1306_point_t *points, uint16_t count, uint8_t pixel_value)
+	{
+	static const uint8_t pixel_bits[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	// dirty spans of batch
+	uint8_t seg_lo[SSD1306_OLED_HEIGHT_MAX / 8];
+	uint8_t seg_hi[SSD1306_OLED_HEIGHT_MAX / 8];
+	memset(&seg_lo[0], 0xFF, sizeof seg_lo);
+	memset(&seg_hi[0], 0x00, sizeof seg_hi);
+
+	uint8_t width  = SSD1306_DEV_WIDTH(dev);
+	uint8_t height = SSD1306_DEV_HEIGHT(dev);
+	for (const ssd1306_point_t *point = points; point < &points[count]; point++)
+		{
+		uint8_t pixel_x = point->x;
+		uint8_t pixel_y = point->y;
+		if ((pixel_x >= width) || (pixel_y >= height))
+			continue;
+
+		// set bit on or off
+		uint8_t pixel_page = pixel_y / 8;
+		uint8_t pixel_bit  = pixel_bits[pixel_y % 8];
+		ssd1306_rop_byte(&SSD1306_BUFFER(dev, pixel_page, pixel_x), pixel_value ? pixel_bit : 0x00, pixel_bit, dev->rop);
+
+		if (pixel_x < seg_lo[pixel_page]) seg_lo[pixel_page] = pixel_x;
+		if (pixel_x > seg_hi[pixel_page]) seg_hi[pixel_page] = pixel_x;
+		}
+
+	// merge batch into device dirty spans
+	for (uint8_t i = 0; i <= SSD1306_DEV_PAGE_MAX(dev); i++)
+		{
+		if (seg_lo[i] < dev->dirty_seg_lo[i]) dev->dirty_seg_lo[i] = seg_lo[i];
+		if (seg_hi[i] > dev->dirty_seg_hi[i]) dev->dirty_seg_hi[i] = seg_hi[i];
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set pixels in an area
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_area_set(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y, uint8_t pixel_value)
+	{
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	// check limits
+	if (start_x > SSD1306_DEV_WIDTH(dev)-1)  return -1;
+	if (end_x   > SSD1306_DEV_WIDTH(dev)-1)  end_x   = (uint8_t)(SSD1306_DEV_WIDTH(dev)-1);
+	if (start_y > SSD1306_DEV_HEIGHT(dev)-1) return -1;
+	if (end_y   > SSD1306_DEV_HEIGHT(dev)-1) end_y   = (uint8_t)(SSD1306_DEV_HEIGHT(dev)-1);
+
+	// whole bytes per page, edge pages masked to area rows
+	uint8_t bits = pixel_value ? 0xFF : 0x00;
+	for (uint8_t i = start_y / 8; i <= end_y / 8; i++)
+		{
+		uint8_t mask = 0xFF;
+		if (i == start_y / 8)
+			mask &= (uint8_t)(0xFF << (start_y % 8));
+		if (i == end_y / 8)
+			mask &= (uint8_t)(0xFF >> (7 - (end_y % 8)));
+
+		uint8_t *byte = &SSD1306_BUFFER(dev, i, start_x);
+		for (uint8_t x = start_x; x <= end_x; x++)
+			ssd1306_rop_byte(byte++, bits, mask, dev->rop);
+		}
+
+	ssd1306_dirty_mark(dev, start_x, end_x, start_y, end_y);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set pixels in area on or off whatever the raster op (clears of fields and widgets)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_area_fill(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y, uint8_t pixel_value)
+	{
+	uint8_t rop = dev->rop;
+	dev->rop = SSD1306_ROP_COPY;
+	int8_t result = ssd1306_area_set(dev, start_x, end_x, start_y, end_y, pixel_value);
+	dev->rop = rop;
+
+	return result;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map bitmap into display buffer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_bitmap(ssd1306_t *dev, uint8_t *bitmap, uint8_t *bitmap_mask,
+		uint8_t bitmap_seg_size, uint8_t bitmap_page_size, uint8_t start_pixel_x, uint8_t start_pixel_y)
+	{
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	// loop through bitmap bytes
+	for (uint8_t x = 0; x < bitmap_seg_size; x++)
+		{
+		// calculate x-position
+		uint8_t x_pos = (uint8_t)(start_pixel_x + x);
+		if (x_pos > (uint8_t)(SSD1306_DEV_WIDTH(dev)-1))
+			break;
+
+		// loop through bitmap pages
+		for (uint8_t i = 0; i < bitmap_page_size; i++)
+			{
+			// calculate y-position of byte
+			uint16_t y_pos = (uint16_t)(start_pixel_y + (i*8));
+			if (y_pos > SSD1306_DEV_HEIGHT(dev)-1)
+				break;
+
+			// get bitmap and bitmap_mask bytes
+			uint8_t bitmap_byte      = bitmap[x + (i*bitmap_seg_size)];
+			uint8_t bitmap_mask_byte = 0xFF;
+			if (bitmap_mask != NULL)
+				bitmap_mask_byte = bitmap_mask[x + (i*bitmap_seg_size)];
+
+			// apply byte across the one or two pages it covers
+			ssd1306_column_write(dev, x_pos, (uint8_t)y_pos, bitmap_byte, bitmap_mask_byte, 8);
+			}
+		}
+
+	// mark bitmap area once
+	uint16_t end_x = (uint16_t)(start_pixel_x + bitmap_seg_size - 1);
+	uint16_t end_y = (uint16_t)(start_pixel_y + (bitmap_page_size * 8) - 1);
+	if ((bitmap_seg_size != 0) && (bitmap_page_size != 0))
+		ssd1306_dirty_mark(dev, start_pixel_x, (end_x > 0xFF) ? 0xFF : (uint8_t)end_x, start_pixel_y, (end_y > 0xFF) ? 0xFF : (uint8_t)end_y);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// transpose 8 row-major bytes into 8 page-format column bytes
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_transpose8(uint8_t *rows, uint8_t *cols, uint8_t bit_order)
+	{
+	memset(&cols[0], 0x00, 8);
+
+	// shift each row into the columns, top row ends up in bit 0
+	for (uint8_t y = 0; y < 8; y++)
+		{
+		uint8_t row = rows[y];
+		for (uint8_t x = 0; x < 8; x++)
+			{
+			cols[x] >>= 1;
+			if (bit_order == SSD1306_ROWMAJOR_LSB)
+				{
+				if (row & 0x01)
+					cols[x] |= 0x80;
+				row >>= 1;
+				}
+			else
+				{
+				if (row & 0x80)
+					cols[x] |= 0x80;
+				row = (uint8_t)(row << 1);
+				}
+			}
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map row-major (XBM/PBM) bitmap into display buffer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_bitmap_rowmajor(ssd1306_t *dev, uint8_t *bitmap, uint8_t *bitmap_mask,
+		uint8_t bitmap_width, uint8_t bitmap_height, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t bit_order)
+	{
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	// rows are padded to whole bytes
+	uint8_t row_bytes = (uint8_t)((bitmap_width + 7) / 8);
+
+	// loop through 8x8 blocks
+	for (uint8_t block_y = 0; block_y < bitmap_height; block_y = (uint8_t)(block_y + 8))
+		{
+		// calculate y-position of block
+		uint8_t y_pos = (uint8_t)(start_pixel_y + block_y);
+		if (y_pos > SSD1306_DEV_HEIGHT(dev)-1)
+			break;
+
+		// rows beyond bitmap height are masked out
+		uint8_t rows_used  = (uint8_t)(bitmap_height - block_y);
+		uint8_t rows_valid = (rows_used >= 8) ? 0xFF : (uint8_t)((1 << rows_used) - 1);
+
+		for (uint8_t byte_x = 0; byte_x < row_bytes; byte_x++)
+			{
+			// calculate x-position of block
+			uint8_t x_pos = (uint8_t)(start_pixel_x + (byte_x * 8));
+			if (x_pos > SSD1306_DEV_WIDTH(dev)-1)
+				break;
+
+			// gather block rows
+			uint8_t rows[8];
+			uint8_t mask_rows[8];
+			for (uint8_t y = 0; y < 8; y++)
+				{
+				rows[y]      = 0x00;
+				mask_rows[y] = 0xFF;
+				if (block_y + y < bitmap_height)
+					{
+					int index = ((block_y + y) * row_bytes) + byte_x;
+					rows[y] = bitmap[index];
+					if (bitmap_mask != NULL)
+						mask_rows[y] = bitmap_mask[index];
+					}
+				}
+
+			// transpose block into page format
+			uint8_t cols[8];
+			uint8_t mask_cols[8];
+			ssd1306_transpose8(&rows[0], &cols[0], bit_order);
+			ssd1306_transpose8(&mask_rows[0], &mask_cols[0], bit_order);
+			for (uint8_t x = 0; x < 8; x++)
+				mask_cols[x] &= rows_valid;
+
+			// columns beyond bitmap width are dropped
+			uint8_t cols_used = (uint8_t)(bitmap_width - (byte_x * 8));
+			if (cols_used > 8)
+				cols_used = 8;
+
+			// bitmap block into buffer
+			if (ssd1306_bitmap(dev, &cols[0], &mask_cols[0], cols_used, 1, x_pos, y_pos))
+				return -1;
+			}
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// get built-in font descriptor
+//----------------------------------------------------------------------------------------------------
+const ssd1306_font_t *ssd1306_font_get(uint8_t font)
+	{
+	if (font == SSD1306_FONT_6X14)
+		return &ssd1306_font6x14;
+
+	return &ssd1306_font5x7;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// get font data and glyph size
+//----------------------------------------------------------------------------------------------------
+const uint8_t *ssd1306_font_info(uint8_t font, uint8_t *font_segs, uint8_t *font_pages)
+	{
+	const ssd1306_font_t *font_desc = ssd1306_font_get(font);
+
+	*font_segs  = font_desc->segs;
+	*font_pages = font_desc->pages;
+	return font_desc->glyphs;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// get glyph data of codepoint (direct index, else binary search of sparse codepoints)
+//----------------------------------------------------------------------------------------------------
+const uint8_t *ssd1306_font_glyph(const ssd1306_font_t *font, uint16_t codepoint)
+	{
+	uint16_t glyph = font->fallback;
+
+	if ((uint16_t)(codepoint - font->first) < font->direct)
+		glyph = (uint16_t)(codepoint - font->first);
+	else if (font->codepoints != NULL)
+		{
+		uint16_t lo = 0;
+		uint16_t hi = font->count;
+		while (lo < hi)
+			{
+			uint16_t mid = (uint16_t)((lo + hi) / 2);
+			uint16_t mid_codepoint = pgm_read_word(&font->codepoints[mid]);
+			if (mid_codepoint == codepoint)
+				{
+				if (font->indices != NULL)
+					glyph = pgm_read_byte(&font->indices[mid]);
+				else
+					glyph = (uint16_t)(font->direct + mid);
+				break;
+				}
+			if (mid_codepoint < codepoint)
+				lo = (uint16_t)(mid + 1);
+			else
+				hi = mid;
+			}
+		}
+
+	return &font->glyphs[(size_t)glyph * (size_t)(font->segs * font->pages)];
+	}
+
+//----------------------------------------------------------------------------------------------------
+// decode next utf-8 character and advance text (codepoints above 0xFFFF decode as invalid)
+//----------------------------------------------------------------------------------------------------
+uint16_t ssd1306_utf8_next(const char **text)
+	{
+	const uint8_t *byte = (const uint8_t *)*text;
+	uint16_t codepoint  = *byte++;
+
+	if (codepoint >= 0x80)
+		{
+		// sequence length from lead byte
+		uint8_t extra;
+		if ((codepoint & 0xE0) == 0xC0)
+			{
+			codepoint &= 0x1F;
+			extra = 1;
+			}
+		else if ((codepoint & 0xF0) == 0xE0)
+			{
+			codepoint &= 0x0F;
+			extra = 2;
+			}
+		else if ((codepoint & 0xF8) == 0xF0)
+			{
+			codepoint = SSD1306_UTF8_INVALID;
+			extra = 3;
+			}
+		else
+			{
+			codepoint = SSD1306_UTF8_INVALID;
+			extra = 0;
+			}
+
+		// continuation bytes
+		for (; extra; extra--)
+			{
+			if ((*byte & 0xC0) != 0x80)
+				{
+				codepoint = SSD1306_UTF8_INVALID;
+				break;
+				}
+			if (codepoint != SSD1306_UTF8_INVALID)
+				codepoint = (uint16_t)((codepoint << 6) | (*byte & 0x3F));
+			byte++;
+			}
+		}
+
+	*text = (const char *)byte;
+	return codepoint;
+	}
+
+#ifdef SSD1306_GLYPH_CACHE
+//----------------------------------------------------------------------------------------------------
+// empty glyph cache
+//----------------------------------------------------------------------------------------------------
+void ssd1306_glyph_cache_clear(void)
+	{
+	memset(&glyph_cache_glyph[0], 0x00, sizeof glyph_cache_glyph);
+	glyph_cache_time = 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// get glyph cache hit and miss counts
+//----------------------------------------------------------------------------------------------------
+void ssd1306_glyph_cache_stats(uint16_t *hits, uint16_t *misses)
+	{
+	*hits   = glyph_cache_hits;
+	*misses = glyph_cache_misses;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// get shifted glyph columns from cache, shifting glyph into least recently used slot on a miss
+//----------------------------------------------------------------------------------------------------
+static uint8_t *ssd1306_glyph_cache_get(const uint8_t *glyph, uint8_t font_segs, uint8_t font_pages, uint8_t shift)
+	{
+	// restart use order when time wraps
+	if (++glyph_cache_time == 0)
+		{
+		ssd1306_glyph_cache_clear();
+		glyph_cache_time = 1;
+		}
+
+	uint8_t slot = 0;
+	for (uint8_t i = 0; i < SSD1306_GLYPH_CACHE_SLOTS; i++)
+		{
+		if ((glyph_cache_glyph[i] == glyph) && (glyph_cache_shift[i] == shift))
+			{
+			glyph_cache_used[i] = glyph_cache_time;
+			glyph_cache_hits++;
+			return &glyph_cache_data[i][0];
+			}
+
+		// free slot, else least recently used
+		if (glyph_cache_glyph[slot] == NULL)
+			continue;
+		if ((glyph_cache_glyph[i] == NULL) || (glyph_cache_used[i] < glyph_cache_used[slot]))
+			slot = (uint8_t)i;
+		}
+	glyph_cache_misses++;
+
+	// shift each column down across one extra page
+	uint8_t font_bytes = (uint8_t)(font_segs * font_pages);
+	uint8_t work[font_bytes];
+	memcpy_P(&work[0], glyph, font_bytes);
+
+	uint8_t *data = &glyph_cache_data[slot][0];
+	for (uint8_t x = 0; x < font_segs; x++)
+		{
+		uint8_t carry = 0;
+		for (uint8_t i = 0; i < font_pages; i++)
+			{
+			uint8_t byte = work[x + (i * font_segs)];
+			data[x + (i * font_segs)] = (uint8_t)((byte << shift) | carry);
+			carry = (uint8_t)(byte >> (8 - shift));
+			}
+		data[x + (font_pages * font_segs)] = carry;
+		}
+
+	glyph_cache_glyph[slot] = glyph;
+	glyph_cache_shift[slot] = shift;
+	glyph_cache_used[slot]  = glyph_cache_time;
+
+	return data;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map glyph at y not on a page boundary into display buffer using glyph cache
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_glyph_cached(ssd1306_t *dev, const uint8_t *glyph, uint8_t font_segs, uint8_t font_pages,
+		uint8_t start_pixel_x, uint8_t start_pixel_y)
+	{
+	uint8_t *data = ssd1306_glyph_cache_get(glyph, font_segs, font_pages, start_pixel_y % 8);
+
+	// glyph bytes are their own mask, as with ssd1306_bitmap()
+	for (uint8_t i = 0; i <= font_pages; i++)
+		{
+		uint8_t page = (uint8_t)((start_pixel_y / 8) + i);
+		if (page > SSD1306_DEV_PAGE_MAX(dev))
+			break;
+
+		for (uint8_t x = 0; x < font_segs; x++)
+			{
+			uint8_t x_pos = (uint8_t)(start_pixel_x + x);
+			if (x_pos > (uint8_t)(SSD1306_DEV_WIDTH(dev)-1))
+				break;
+
+			uint8_t byte = data[x + (i * font_segs)];
+			ssd1306_rop_byte(&SSD1306_BUFFER(dev, page, x_pos), byte, byte, dev->rop);
+			}
+		}
+
+	// mark glyph area as ssd1306_bitmap() does
+	uint16_t end_x = (uint16_t)(start_pixel_x + font_segs - 1);
+	uint16_t end_y = (uint16_t)(start_pixel_y + (font_pages * 8) - 1);
+	ssd1306_dirty_mark(dev, start_pixel_x, (end_x > 0xFF) ? 0xFF : (uint8_t)end_x, start_pixel_y, (end_y > 0xFF) ? 0xFF : (uint8_t)end_y);
+	}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// map text into display buffer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_text(ssd1306_t *dev, char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t font)
+	{
+	return ssd1306_text_font(dev, text, start_pixel_x, start_pixel_y, ssd1306_font_get(font));
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map utf-8 text into display buffer using font descriptor
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_text_font(ssd1306_t *dev, const char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, const ssd1306_font_t *font)
+	{
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	uint8_t font_segs  = font->segs;
+	uint8_t font_pages = font->pages;
+	uint8_t font_bytes = (uint8_t)(font_segs * font_pages);
+
+	// loop through string characters
+	while (*text != '\0')
+		{
+		const uint8_t *glyph = ssd1306_font_glyph(font, ssd1306_utf8_next(&text));
+
+#ifdef SSD1306_GLYPH_CACHE
+		// glyphs off page boundaries come pre-shifted from cache
+		if ((start_pixel_y % 8) && (start_pixel_y < SSD1306_DEV_HEIGHT(dev))
+				&& ((font_bytes + font_segs) <= SSD1306_GLYPH_CACHE_SLOT))
+			ssd1306_glyph_cached(dev, glyph, font_segs, font_pages, start_pixel_x, start_pixel_y);
+		else
+#endif
+			{
+			// get character font bytes from flash
+			uint8_t work[font_bytes];
+			memcpy_P(&work[0], glyph, font_bytes);
+
+			// bitmap font into buffer
+			if (ssd1306_bitmap(dev, &work[0], &work[0], font_segs, font_pages, start_pixel_x, start_pixel_y))
+				return -1;
+			}
+
+		// increment to next character display position
+		start_pixel_x = (uint8_t)(start_pixel_x + font_segs);
+		if (start_pixel_x > (uint8_t)(SSD1306_DEV_WIDTH(dev)-1))
+			break;
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// spread each bit of byte to scale bits (scale 1 to 4)
+//----------------------------------------------------------------------------------------------------
+static uint32_t ssd1306_spread(uint8_t byte, uint8_t scale)
+	{
+	uint8_t lo = byte & 0x0F;
+	uint8_t hi = byte >> 4;
+
+	switch (scale)
+		{
+		case 2:
+			return (uint32_t)pgm_read_byte(&spread2_tx[lo]) | ((uint32_t)pgm_read_byte(&spread2_tx[hi]) << 8);
+		case 3:
+			return (uint32_t)pgm_read_word(&spread3_tx[lo]) | ((uint32_t)pgm_read_word(&spread3_tx[hi]) << 12);
+		case 4:
+			return (uint32_t)pgm_read_word(&spread4_tx[lo]) | ((uint32_t)pgm_read_word(&spread4_tx[hi]) << 16);
+		default:
+			return byte;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map scaled text into display buffer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_text_scaled(ssd1306_t *dev, const char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t font, uint8_t scale)
+	{
+	return ssd1306_text_font_scaled(dev, text, start_pixel_x, start_pixel_y, ssd1306_font_get(font), scale);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map utf-8 text scaled 1 to 4 times into display buffer using font descriptor
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_text_font_scaled(ssd1306_t *dev, const char *text, uint8_t start_pixel_x, uint8_t start_pixel_y,
+		const ssd1306_font_t *font, uint8_t scale)
+	{
+	// check for valid device
+	if (SSD1306_DRAW_INVALID(dev))
+		return -1;
+
+	// check limits
+	if ((scale < 1) || (scale > 4))
+		return -1;
+	if ((start_pixel_x > SSD1306_DEV_SEG_MAX(dev)) || (start_pixel_y > SSD1306_DEV_HEIGHT(dev)-1))
+		return -1;
+	if (scale == 1)
+		return ssd1306_text_font(dev, text, start_pixel_x, start_pixel_y, font);
+
+	uint8_t font_segs  = font->segs;
+	uint8_t font_pages = font->pages;
+	uint8_t bit_count  = (uint8_t)(8 * scale);
+	uint8_t x_pos      = start_pixel_x;
+
+	// loop through string characters
+	while ((*text != '\0') && (x_pos <= SSD1306_DEV_SEG_MAX(dev)))
+		{
+		const uint8_t *glyph = ssd1306_font_glyph(font, ssd1306_utf8_next(&text));
+
+		// spread each glyph byte once and write it to scale columns
+		for (uint8_t x = 0; x < font_segs; x++)
+			{
+			for (uint8_t i = 0; i < font_pages; i++)
+				{
+				uint16_t y_pos = (uint16_t)(start_pixel_y + (i * bit_count));
+				if (y_pos > SSD1306_DEV_HEIGHT(dev)-1)
+					break;
+
+				uint32_t bits = ssd1306_spread(pgm_read_byte(&glyph[x + (i * font_segs)]), scale);
+				for (uint8_t j = 0; j < scale; j++)
+					if ((uint8_t)(x_pos + j) <= SSD1306_DEV_SEG_MAX(dev))
+						ssd1306_column_write(dev, (uint8_t)(x_pos + j), (uint8_t)y_pos, bits, bits, bit_count);
+				}
+
+			x_pos = (uint8_t)(x_pos + scale);
+			if (x_pos > SSD1306_DEV_SEG_MAX(dev))
+				break;
+			}
+		}
+
+	// mark drawn area once
+	uint16_t end_y = (uint16_t)(start_pixel_y + (font_pages * bit_count) - 1);
+	if (end_y > SSD1306_DEV_HEIGHT(dev)-1)
+		end_y = (uint16_t)(SSD1306_DEV_HEIGHT(dev)-1);
+	if (x_pos > start_pixel_x)
+		ssd1306_dirty_mark(dev, start_pixel_x, (uint8_t)(x_pos - 1), start_pixel_y, (uint8_t)end_y);
+
+	return 0;
+	}
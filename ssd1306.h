@@ -25,6 +25,21 @@ extern const uint8_t PROGMEM font6x14[];
 #define DEV_VALID   0xFF
 #define DEV_INVALID 0xFE
 
+// millisecond tick source, free running and allowed to wrap
+typedef uint16_t (*ssd1306_tick_t)(void);
+
+// bus statistics
+typedef struct ssd1306_stats
+	{
+	uint16_t naks;      // transfers rejected by the bus driver
+	uint16_t timeouts;  // transfers that exceeded the time budget
+	uint16_t retries;   // transfers repeated after an error
+	uint32_t bytes;     // payload bytes sent
+	} ssd1306_stats_t;
+
+// display areas recorded between ssd1306_frame_begin() and ssd1306_frame_commit()
+#define SSD1306_FRAME_AREAS_MAX 8
+
 // display device structure
 typedef struct ssd1306
 	{
@@ -37,30 +52,214 @@ typedef struct ssd1306
 	uint8_t oled_height;
 	uint8_t oled_seg_max;
 	uint8_t oled_page_max;
+
+	// page-format buffer, display_buffer unless set otherwise
+	uint8_t  *buffer;
+	uint16_t  buffer_stride;
+
+	// changed segment span of each page (lo > hi when clean)
+	uint8_t dirty_seg_lo[SSD1306_OLED_HEIGHT_MAX / 8];
+	uint8_t dirty_seg_hi[SSD1306_OLED_HEIGHT_MAX / 8];
+
+	// bus error handling
+	uint8_t         bus_retries;
+	uint8_t         bus_offline;
+	uint16_t        bus_timeout_ms;
+	uint16_t        bus_holdoff_ms;
+	uint16_t        bus_fail_tick;
+	ssd1306_tick_t  tick;
+	ssd1306_stats_t stats;
+
+	// raster operation of drawing calls
+	uint8_t rop;
+
+	// controller memory addressing mode, window commands switch it when needed
+	uint8_t addr_mode;
+
+	// user that set the display window last, cleared by every transfer
+	const void *window_owner;
+
+	// resumable flush job
+	uint8_t flush_state;
+	uint8_t flush_window;     // display window still set for job, cleared by other transfers
+	uint8_t flush_page;       // next byte to send
+	uint8_t flush_seg;
+	uint8_t flush_area[4];    // start page, end page, start seg, end seg
+	uint8_t flush_next[4];    // area requested while busy, merged
+	uint8_t flush_next_valid;
+
+	// deferred frame, display calls recorded and merged until commit
+	uint8_t frame_active;
+	uint8_t frame_count;
+	uint8_t frame_area[SSD1306_FRAME_AREAS_MAX][4]; // start page, end page, start seg, end seg
 	} ssd1306_t;
 
+// compile-time configuration
+#ifdef SSD1306_CONFIG
+#include "ssd1306_config.h"
+#endif
+
+// device settings, constants where set by ssd1306_config.h
+#ifdef SSD1306_CONFIG_BUS
+	#define SSD1306_DEV_BUS(dev)      (SSD1306_CONFIG_BUS)
+#else
+	#define SSD1306_DEV_BUS(dev)      ((dev)->bus_type)
+#endif
+#ifdef SSD1306_CONFIG_ADDR
+	#define SSD1306_DEV_ADDR(dev)     (SSD1306_CONFIG_ADDR)
+#else
+	#define SSD1306_DEV_ADDR(dev)     ((dev)->i2c_addr)
+#endif
+#ifdef SSD1306_CONFIG_WIDTH
+	#define SSD1306_DEV_WIDTH(dev)    (SSD1306_CONFIG_WIDTH)
+	#define SSD1306_DEV_SEG_MAX(dev)  (SSD1306_CONFIG_WIDTH - 1)
+#else
+	#define SSD1306_DEV_WIDTH(dev)    ((dev)->oled_width)
+	#define SSD1306_DEV_SEG_MAX(dev)  ((dev)->oled_seg_max)
+#endif
+#ifdef SSD1306_CONFIG_HEIGHT
+	#define SSD1306_DEV_HEIGHT(dev)   (SSD1306_CONFIG_HEIGHT)
+	#define SSD1306_DEV_PAGE_MAX(dev) ((SSD1306_CONFIG_HEIGHT / 8) - 1)
+#else
+	#define SSD1306_DEV_HEIGHT(dev)   ((dev)->oled_height)
+	#define SSD1306_DEV_PAGE_MAX(dev) ((dev)->oled_page_max)
+#endif
+#ifdef SSD1306_CONFIG_NO_CHECK
+	#define SSD1306_DRAW_INVALID(dev) (0)
+#else
+	#define SSD1306_DRAW_INVALID(dev) ((dev)->valid_flag != DEV_VALID)
+#endif
+
+// initialize display with compile-time configuration, all settings defined
+#if defined (SSD1306_CONFIG_WIDTH) && defined (SSD1306_CONFIG_HEIGHT) && defined (SSD1306_CONFIG_BUS) && \
+		defined (SSD1306_CONFIG_ADDR) && defined (SSD1306_CONFIG_RESET_PIN) && defined (SSD1306_CONFIG_DC_PIN)
+	#define SSD1306_CONFIG_INIT(dev) ssd1306_init((dev), SSD1306_CONFIG_WIDTH, SSD1306_CONFIG_HEIGHT, SSD1306_CONFIG_BUS, \
+			SSD1306_CONFIG_ADDR, SSD1306_CONFIG_RESET_PIN, SSD1306_CONFIG_DC_PIN)
+#endif
+
+// glyph cache for text at y not on a page boundary, build with -D SSD1306_GLYPH_CACHE
+// each slot holds one glyph shifted across font pages + 1 pages, larger glyphs bypass the cache
+#ifndef SSD1306_GLYPH_CACHE_BYTES
+	#define SSD1306_GLYPH_CACHE_BYTES 200
+#endif
+#ifndef SSD1306_GLYPH_CACHE_SLOT
+	#define SSD1306_GLYPH_CACHE_SLOT  10  // 5x7 font
+#endif
+
+// flush job states
+#define SSD1306_FLUSH_IDLE     0x00
+#define SSD1306_FLUSH_BUSY     0x01
+
+// flush job display window
+#define SSD1306_FLUSH_WIN_NONE 0x00
+#define SSD1306_FLUSH_WIN_AREA 0x01 // remaining pages of area
+#define SSD1306_FLUSH_WIN_ROW  0x02 // rest of current page row
+
 // display buffer array
 extern uint8_t display_buffer[(SSD1306_OLED_HEIGHT_MAX / 8)] [SSD1306_OLED_WIDTH_MAX];
 
+// buffer byte of device at page,seg
+#define SSD1306_BUFFER(dev, page, seg) ((dev)->buffer[((page) * (dev)->buffer_stride) + (seg)])
+
 // data/command select
 #define SSD1306_DC_CMD     0x00
 #define SSD1306_DC_DATA    0x40
 
+// ssd1306_send() result when a transfer failed after the controller took part of it,
+// display address has moved so the window must be set again before resending
+#define SSD1306_SEND_PARTIAL (-2)
+
 // included fonts
 #define SSD1306_FONT_5X7   0x01
 #define SSD1306_FONT_6X14  0x02
 
+// font descriptor, glyphs are segs * pages bytes in page format
+typedef struct ssd1306_font
+	{
+	const uint8_t  *glyphs;     // glyph data in flash
+	const uint16_t *codepoints; // sorted codepoints outside direct range in flash, NULL if none
+	const uint8_t  *indices;    // glyph of each codepoint in flash, NULL if glyphs follow direct range in order
+	uint16_t        first;      // first codepoint of direct range
+	uint16_t        direct;     // codepoints in direct range, glyph = codepoint - first
+	uint16_t        count;      // entries in codepoints
+	uint16_t        fallback;   // glyph for missing codepoints
+	uint8_t         segs;
+	uint8_t         pages;
+	} ssd1306_font_t;
+
+// built-in font descriptors
+extern const ssd1306_font_t ssd1306_font5x7;
+extern const ssd1306_font_t ssd1306_font6x14;
+
+// decoded invalid utf-8 sequence
+#define SSD1306_UTF8_INVALID 0xFFFD
+
+// display point
+typedef struct ssd1306_point
+	{
+	uint8_t x;
+	uint8_t y;
+	} ssd1306_point_t;
+
+// raster operations, applied where the source mask is set
+#define SSD1306_ROP_COPY   0x00 // destination = source (default)
+#define SSD1306_ROP_OR     0x01 // set source pixels
+#define SSD1306_ROP_ANDNOT 0x02 // clear source pixels
+#define SSD1306_ROP_XOR    0x03 // toggle source pixels, drawing twice restores
+#define SSD1306_ROP_INVERT 0x04 // toggle covered pixels, source ignored
+
+// row-major bitmap bit order (leftmost pixel in byte)
+#define SSD1306_ROWMAJOR_MSB 0x00 // PBM
+#define SSD1306_ROWMAJOR_LSB 0x01 // XBM
+
 // prototypes
 int8_t ssd1306_send(ssd1306_t *dev, uint8_t *data, size_t size, uint8_t dc_flag);
+void   ssd1306_bus_config(ssd1306_t *dev, uint8_t retries, uint16_t timeout_ms, uint16_t holdoff_ms, ssd1306_tick_t tick);
+void   ssd1306_stats_clear(ssd1306_t *dev);
+int8_t ssd1306_send_P(ssd1306_t *dev, const uint8_t *data, size_t size, uint8_t dc_flag);
 int8_t ssd1306_init(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus, uint8_t addr, uint8_t reset_pin, uint8_t dc_pin);
+int8_t ssd1306_init_warm(ssd1306_t *dev, uint8_t width, uint8_t height, uint8_t bus, uint8_t addr, uint8_t reset_pin, uint8_t dc_pin);
+int8_t ssd1306_window(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg);
+int8_t ssd1306_window_mode(ssd1306_t *dev, uint8_t mode, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg);
 int8_t ssd1306_display(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg);
+void   ssd1306_buffer_set(ssd1306_t *dev, uint8_t *buffer, uint16_t stride);
+void   ssd1306_dirty_mark(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y);
+void   ssd1306_dirty_clear(ssd1306_t *dev);
+int8_t ssd1306_display_dirty(ssd1306_t *dev);
+int8_t ssd1306_flush_start(ssd1306_t *dev, uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg);
+int8_t ssd1306_flush_dirty(ssd1306_t *dev);
+int8_t ssd1306_flush_step(ssd1306_t *dev, uint16_t byte_budget);
+int8_t ssd1306_frame_begin(ssd1306_t *dev);
+int8_t ssd1306_frame_commit(ssd1306_t *dev);
 
 void   ssd1306_clear_buffer(void);
+void   ssd1306_clear(ssd1306_t *dev);
+void   ssd1306_rop_set(ssd1306_t *dev, uint8_t rop);
 int8_t ssd1306_pixel_set(ssd1306_t *dev, uint8_t pixel_x, uint8_t pixel_y, uint8_t pixel_value);
+int8_t ssd1306_pixels_set(ssd1306_t *dev, const ssd1306_point_t *points, uint16_t count, uint8_t pixel_value);
 int8_t ssd1306_area_set(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y, uint8_t pixel_value);
+int8_t ssd1306_area_fill(ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y, uint8_t pixel_value);
 int8_t ssd1306_bitmap(ssd1306_t *dev, uint8_t *bitmap, uint8_t *bitmap_mask,
 		uint8_t bitmap_seg_size, uint8_t bitmap_page_size, uint8_t start_pixel_x, uint8_t start_pixel_y);
+int8_t ssd1306_bitmap_rowmajor(ssd1306_t *dev, uint8_t *bitmap, uint8_t *bitmap_mask,
+		uint8_t bitmap_width, uint8_t bitmap_height, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t bit_order);
+#ifdef SSD1306_WIRE_LOG
+void   ssd1306_wire_log_buffer(ssd1306_t *dev);
+#endif
+
+const ssd1306_font_t *ssd1306_font_get(uint8_t font);
+const uint8_t *ssd1306_font_info(uint8_t font, uint8_t *font_segs, uint8_t *font_pages);
+const uint8_t *ssd1306_font_glyph(const ssd1306_font_t *font, uint16_t codepoint);
+uint16_t ssd1306_utf8_next(const char **text);
 int8_t ssd1306_text(ssd1306_t *dev, char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t font);
+int8_t ssd1306_text_font(ssd1306_t *dev, const char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, const ssd1306_font_t *font);
+#ifdef SSD1306_GLYPH_CACHE
+void   ssd1306_glyph_cache_clear(void);
+void   ssd1306_glyph_cache_stats(uint16_t *hits, uint16_t *misses);
+#endif
+int8_t ssd1306_text_scaled(ssd1306_t *dev, const char *text, uint8_t start_pixel_x, uint8_t start_pixel_y, uint8_t font, uint8_t scale);
+int8_t ssd1306_text_font_scaled(ssd1306_t *dev, const char *text, uint8_t start_pixel_x, uint8_t start_pixel_y,
+		const ssd1306_font_t *font, uint8_t scale);
 
 // ssd1306 commands
 
@@ -89,6 +288,7 @@ int8_t ssd1306_text(ssd1306_t *dev, char *text, uint8_t start_pixel_x, uint8_t s
 #define SSD1306_MODE_HORIZONTAL     0x00
 #define SSD1306_MODE_VERTICAL       0x01
 #define SSD1306_MODE_PAGE           0x02
+#define SSD1306_MODE_UNKNOWN        0xFF // after failed mode command
 #define SSD1306_COLUMNADDR          0x21
 #define SSD1306_PAGEADDR            0x22
 
@@ -115,5 +315,7 @@ int8_t ssd1306_text(ssd1306_t *dev, char *text, uint8_t start_pixel_x, uint8_t s
 #define SSD1306_LEFT_HORIZONTAL_SCROLL               0x27
 #define SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL 0x29
 #define SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL  0x2A
+#define SSD1306_RIGHT_CONTENT_SCROLL                 0x2C // one column, SSD1306B
+#define SSD1306_LEFT_CONTENT_SCROLL                  0x2D // one column, SSD1306B
 
 #endif // SSD1306_H_
@@ -0,0 +1,152 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_anim.h"
+
+//----------------------------------------------------------------------------------------------------
+// initialize player for PROGMEM animation at page,seg and clear its area on the panel
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_anim_init(ssd1306_anim_t *anim, ssd1306_t *dev, const uint8_t *data, uint8_t start_page, uint8_t start_seg)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	uint8_t seg_count  = pgm_read_byte(&data[0]);
+	uint8_t page_count = pgm_read_byte(&data[1]);
+
+	// check limits
+	if ((seg_count == 0) || (page_count == 0))
+		return -1;
+	if ((start_page + page_count - 1 > SSD1306_DEV_PAGE_MAX(dev)) || (start_seg + seg_count - 1 > SSD1306_DEV_SEG_MAX(dev)))
+		return -1;
+
+	anim->dev         = dev;
+	anim->data        = data;
+	anim->next        = &data[SSD1306_ANIM_HEADER_SIZE];
+	anim->loop        = NULL;
+	anim->frame       = 0;
+	anim->frame_count = pgm_read_word(&data[2]);
+	anim->period_ms   = pgm_read_word(&data[4]);
+	anim->last_ms     = 0;
+	anim->start_page  = start_page;
+	anim->start_seg   = start_seg;
+	anim->page_count  = page_count;
+	anim->seg_count   = seg_count;
+	anim->flags       = pgm_read_byte(&data[6]);
+	anim->running     = 0;
+
+	// keyframe is a delta from a blank area, blank the panel too so bytes outside its window match
+	for (uint8_t i = 0; i < page_count; i++)
+		memset(&SSD1306_BUFFER(dev, start_page + i, start_seg), 0x00, seg_count);
+
+	return ssd1306_display(dev, start_page, (uint8_t)(start_page + page_count - 1), start_seg, (uint8_t)(start_seg + seg_count - 1));
+	}
+
+//----------------------------------------------------------------------------------------------------
+// apply next frame delta to the buffer and display the changed window, 1 when finished
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_anim_step(ssd1306_anim_t *anim)
+	{
+	ssd1306_t *dev = anim->dev;
+
+	// after last frame, rewind through loop delta or stop
+	if (anim->frame >= anim->frame_count)
+		{
+		if (!(anim->flags & SSD1306_ANIM_LOOP) || (anim->loop == NULL))
+			return 1;
+		anim->frame = 0;
+		}
+
+	const uint8_t *p = anim->next;
+	uint8_t start_page = pgm_read_byte(p++);
+	if (start_page != SSD1306_ANIM_EMPTY)
+		{
+		uint8_t end_page  = pgm_read_byte(p++);
+		uint8_t start_seg = pgm_read_byte(p++);
+		uint8_t end_seg   = pgm_read_byte(p++);
+
+		// check limits
+		if ((start_page > end_page) || (end_page >= anim->page_count) ||
+				(start_seg > end_seg) || (end_seg >= anim->seg_count))
+			return -1;
+
+		// decode tokens across window, page by page
+		uint8_t  page = start_page;
+		uint8_t  seg  = start_seg;
+		uint16_t left = (uint16_t)((end_page - start_page + 1) * (end_seg - start_seg + 1));
+		while (left)
+			{
+			uint8_t token = pgm_read_byte(p++);
+			uint8_t run   = (uint8_t)((token & 0x7F) + 1);
+			if (run > left)
+				return -1;
+			left = (uint16_t)(left - run);
+
+			while (run)
+				{
+				uint8_t count = (uint8_t)(end_seg - seg + 1);
+				if (count > run)
+					count = run;
+
+				if (!(token & SSD1306_ANIM_SKIP))
+					{
+					uint8_t *byte = &SSD1306_BUFFER(dev, anim->start_page + page, anim->start_seg + seg);
+					for (uint8_t i = 0; i < count; i++)
+						byte[i] ^= pgm_read_byte(p++);
+					}
+
+				run = (uint8_t)(run - count);
+				seg = (uint8_t)(seg + count);
+				if (seg > end_seg)
+					{
+					seg = start_seg;
+					page++;
+					}
+				}
+			}
+
+		if (ssd1306_display(dev, (uint8_t)(anim->start_page + start_page), (uint8_t)(anim->start_page + end_page),
+				(uint8_t)(anim->start_seg + start_seg), (uint8_t)(anim->start_seg + end_seg)))
+			return -1;
+		}
+
+	// loop delta returns to keyframe, continue with the frame after it
+	anim->frame++;
+	if (anim->frame == 1)
+		{
+		if (anim->loop == NULL)
+			anim->loop = p;
+		else
+			p = anim->loop;
+		}
+	anim->next = p;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// step animation when frame period has passed, 1 when finished
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_anim_update(ssd1306_anim_t *anim, uint16_t now_ms)
+	{
+	if (anim->running)
+		{
+		if ((uint16_t)(now_ms - anim->last_ms) < anim->period_ms)
+			return 0;
+
+		// keep frame rate without drift, resynchronize when too far behind
+		anim->last_ms = (uint16_t)(anim->last_ms + anim->period_ms);
+		if ((uint16_t)(now_ms - anim->last_ms) >= anim->period_ms)
+			anim->last_ms = now_ms;
+		}
+	else
+		{
+		anim->last_ms = now_ms;
+		anim->running = 1;
+		}
+
+	return ssd1306_anim_step(anim);
+	}
@@ -0,0 +1,41 @@
+#ifndef SSD1306_ANIM_H_
+#define SSD1306_ANIM_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// animation header: segs, pages, frame count (le16), frame period ms (le16), flags
+#define SSD1306_ANIM_HEADER_SIZE 7
+#define SSD1306_ANIM_LOOP        0x01 // loop delta from last frame back to keyframe follows last frame
+
+// frame: start page, end page, start seg, end seg relative to animation, then tokens filling the window
+#define SSD1306_ANIM_EMPTY       0xFF // start page of frame without changes, no window or tokens follow
+#define SSD1306_ANIM_SKIP        0x80 // token bit 7 set: skip (token & 0x7F) + 1 bytes
+                                      // token bit 7 clear: xor next (token + 1) bytes
+
+// animation player structure
+typedef struct ssd1306_anim
+	{
+	ssd1306_t     *dev;
+	const uint8_t *data;       // PROGMEM animation
+	const uint8_t *next;       // next frame
+	const uint8_t *loop;       // first frame after keyframe
+	uint16_t       frame;      // index of next frame
+	uint16_t       frame_count;
+	uint16_t       period_ms;
+	uint16_t       last_ms;
+	uint8_t        start_page;
+	uint8_t        start_seg;
+	uint8_t        page_count;
+	uint8_t        seg_count;
+	uint8_t        flags;
+	uint8_t        running;
+	} ssd1306_anim_t;
+
+// prototypes
+int8_t ssd1306_anim_init(ssd1306_anim_t *anim, ssd1306_t *dev, const uint8_t *data, uint8_t start_page, uint8_t start_seg);
+int8_t ssd1306_anim_step(ssd1306_anim_t *anim);
+int8_t ssd1306_anim_update(ssd1306_anim_t *anim, uint16_t now_ms);
+
+#endif // SSD1306_ANIM_H_
@@ -0,0 +1,189 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_canvas.h"
+
+//----------------------------------------------------------------------------------------------------
+// initialize canvas over panels of equal height, buffer holds SSD1306_CANVAS_SIZE bytes
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_canvas_init(ssd1306_canvas_t *canvas, uint8_t *buffer, ssd1306_t **panels, uint8_t panel_count)
+	{
+	// check limits
+	if ((panel_count == 0) || (panel_count > SSD1306_CANVAS_PANELS_MAX))
+		return -1;
+
+	canvas->panel_count = panel_count;
+	canvas->buffer      = buffer;
+	canvas->width       = 0;
+
+	// place panels side by side, first panel is checked before its height is compared
+	for (uint8_t i = 0; i < panel_count; i++)
+		{
+		if ((panels[i]->valid_flag != DEV_VALID) || (SSD1306_DEV_HEIGHT(panels[i]) != SSD1306_DEV_HEIGHT(panels[0])))
+			return -1;
+
+		canvas->panels[i]  = panels[i];
+		canvas->panel_x[i] = canvas->width;
+		canvas->width      = (uint16_t)(canvas->width + SSD1306_DEV_WIDTH(panels[i]));
+		}
+	canvas->height = (uint8_t)SSD1306_DEV_HEIGHT(panels[0]);
+
+	// panels draw into and display from their slice of the canvas buffer
+	for (uint8_t i = 0; i < panel_count; i++)
+		ssd1306_buffer_set(canvas->panels[i], &canvas->buffer[canvas->panel_x[i]], canvas->width);
+
+	ssd1306_canvas_clear(canvas);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear canvas buffer and mark all panels changed
+//----------------------------------------------------------------------------------------------------
+void ssd1306_canvas_clear(ssd1306_canvas_t *canvas)
+	{
+	memset(canvas->buffer, 0x00, SSD1306_CANVAS_SIZE(canvas->width, canvas->height));
+
+	for (uint8_t i = 0; i < canvas->panel_count; i++)
+		{
+		ssd1306_t *panel = canvas->panels[i];
+		ssd1306_dirty_mark(panel, 0, SSD1306_DEV_SEG_MAX(panel), 0, (uint8_t)(SSD1306_DEV_HEIGHT(panel) - 1));
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set pixel at canvas x,y
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_canvas_pixel_set(ssd1306_canvas_t *canvas, uint16_t pixel_x, uint8_t pixel_y, uint8_t pixel_value)
+	{
+	// check limits
+	if (pixel_x > canvas->width-1)
+		return -1;
+
+	// find panel holding x
+	for (uint8_t i = canvas->panel_count; i-- > 0; )
+		if (pixel_x >= canvas->panel_x[i])
+			return ssd1306_pixel_set(canvas->panels[i], (uint8_t)(pixel_x - canvas->panel_x[i]), pixel_y, pixel_value);
+
+	return -1;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set pixels in a canvas area, split across panels
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_canvas_area_set(ssd1306_canvas_t *canvas, uint16_t start_x, uint16_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t pixel_value)
+	{
+	// check limits
+	if (start_x > canvas->width-1)  return -1;
+	if (end_x   > canvas->width-1)  end_x = (uint16_t)(canvas->width-1);
+
+	for (uint8_t i = 0; i < canvas->panel_count; i++)
+		{
+		ssd1306_t *panel   = canvas->panels[i];
+		uint16_t panel_end = (uint16_t)(canvas->panel_x[i] + SSD1306_DEV_SEG_MAX(panel));
+
+		// skip panels outside area
+		if ((end_x < canvas->panel_x[i]) || (start_x > panel_end))
+			continue;
+
+		uint8_t x0 = (start_x > canvas->panel_x[i]) ? (uint8_t)(start_x - canvas->panel_x[i]) : 0;
+		uint8_t x1 = (end_x   < panel_end)          ? (uint8_t)(end_x   - canvas->panel_x[i]) : SSD1306_DEV_SEG_MAX(panel);
+		if (ssd1306_area_set(panel, x0, x1, start_y, end_y, pixel_value))
+			return -1;
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map bitmap into canvas, bitmaps crossing a panel edge are split into per-page strips
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_canvas_bitmap(ssd1306_canvas_t *canvas, uint8_t *bitmap, uint8_t *bitmap_mask,
+		uint8_t bitmap_seg_size, uint8_t bitmap_page_size, uint16_t start_pixel_x, uint8_t start_pixel_y)
+	{
+	uint16_t end_x = (uint16_t)(start_pixel_x + bitmap_seg_size - 1);
+
+	for (uint8_t i = 0; i < canvas->panel_count; i++)
+		{
+		ssd1306_t *panel   = canvas->panels[i];
+		uint16_t panel_end = (uint16_t)(canvas->panel_x[i] + SSD1306_DEV_SEG_MAX(panel));
+
+		// skip panels outside bitmap
+		if ((end_x < canvas->panel_x[i]) || (start_pixel_x > panel_end))
+			continue;
+
+		// bitmap fully inside panel
+		if ((start_pixel_x >= canvas->panel_x[i]) && (end_x <= panel_end))
+			return ssd1306_bitmap(panel, bitmap, bitmap_mask, bitmap_seg_size, bitmap_page_size,
+					(uint8_t)(start_pixel_x - canvas->panel_x[i]), start_pixel_y);
+
+		// columns of bitmap on this panel
+		uint8_t first = (start_pixel_x < canvas->panel_x[i]) ? (uint8_t)(canvas->panel_x[i] - start_pixel_x) : 0;
+		uint8_t last  = (end_x > panel_end) ? (uint8_t)(panel_end - start_pixel_x) : (uint8_t)(bitmap_seg_size - 1);
+		uint8_t x_pos = (uint8_t)((start_pixel_x + first) - canvas->panel_x[i]);
+
+		// one page strip at a time keeps the source stride
+		for (uint8_t j = 0; j < bitmap_page_size; j++)
+			{
+			uint16_t offset = (uint16_t)((j * bitmap_seg_size) + first);
+			uint8_t *mask   = (bitmap_mask != NULL) ? &bitmap_mask[offset] : NULL;
+			if (ssd1306_bitmap(panel, &bitmap[offset], mask, (uint8_t)((last - first) + 1), 1,
+					x_pos, (uint8_t)(start_pixel_y + (j * 8))))
+				return -1;
+			}
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// map utf-8 text into canvas
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_canvas_text(ssd1306_canvas_t *canvas, const char *text, uint16_t start_pixel_x, uint8_t start_pixel_y, uint8_t font)
+	{
+	const ssd1306_font_t *font_desc = ssd1306_font_get(font);
+	uint8_t font_bytes = (uint8_t)(font_desc->segs * font_desc->pages);
+
+	// loop through string characters
+	while ((*text != '\0') && (start_pixel_x < canvas->width))
+		{
+		// get character font bytes from flash
+		uint8_t work[font_bytes];
+		memcpy_P(&work[0], ssd1306_font_glyph(font_desc, ssd1306_utf8_next(&text)), font_bytes);
+
+		// bitmap font into canvas
+		if (ssd1306_canvas_bitmap(canvas, &work[0], &work[0], font_desc->segs, font_desc->pages, start_pixel_x, start_pixel_y))
+			return -1;
+
+		start_pixel_x = (uint16_t)(start_pixel_x + font_desc->segs);
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send changed areas of all panels, interleaved page by page on the shared bus
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_canvas_display(ssd1306_canvas_t *canvas)
+	{
+	uint8_t page_max = (uint8_t)SSD1306_DEV_PAGE_MAX(canvas->panels[0]);
+
+	for (uint8_t page = 0; page <= page_max; page++)
+		for (uint8_t i = 0; i < canvas->panel_count; i++)
+			{
+			ssd1306_t *panel = canvas->panels[i];
+			if (panel->dirty_seg_lo[page] > panel->dirty_seg_hi[page])
+				continue;
+
+			if (ssd1306_display(panel, page, page, panel->dirty_seg_lo[page], panel->dirty_seg_hi[page]))
+				return -1;
+			}
+
+	for (uint8_t i = 0; i < canvas->panel_count; i++)
+		ssd1306_dirty_clear(canvas->panels[i]);
+
+	return 0;
+	}
@@ -0,0 +1,36 @@
+#ifndef SSD1306_CANVAS_H_
+#define SSD1306_CANVAS_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// panel limit
+#define SSD1306_CANVAS_PANELS_MAX 4
+
+// canvas buffer size
+#define SSD1306_CANVAS_SIZE(width, height) ((size_t)(width) * ((height) / 8))
+
+// canvas structure, panels placed left to right
+typedef struct ssd1306_canvas
+	{
+	ssd1306_t *panels[SSD1306_CANVAS_PANELS_MAX];
+	uint16_t   panel_x[SSD1306_CANVAS_PANELS_MAX];   // canvas x of each panel
+	uint8_t    panel_count;
+	uint8_t   *buffer;                               // combined page-format buffer
+	uint16_t   width;
+	uint8_t    height;
+	} ssd1306_canvas_t;
+
+// prototypes
+int8_t ssd1306_canvas_init(ssd1306_canvas_t *canvas, uint8_t *buffer, ssd1306_t **panels, uint8_t panel_count);
+void   ssd1306_canvas_clear(ssd1306_canvas_t *canvas);
+int8_t ssd1306_canvas_pixel_set(ssd1306_canvas_t *canvas, uint16_t pixel_x, uint8_t pixel_y, uint8_t pixel_value);
+int8_t ssd1306_canvas_area_set(ssd1306_canvas_t *canvas, uint16_t start_x, uint16_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t pixel_value);
+int8_t ssd1306_canvas_bitmap(ssd1306_canvas_t *canvas, uint8_t *bitmap, uint8_t *bitmap_mask,
+		uint8_t bitmap_seg_size, uint8_t bitmap_page_size, uint16_t start_pixel_x, uint8_t start_pixel_y);
+int8_t ssd1306_canvas_text(ssd1306_canvas_t *canvas, const char *text, uint16_t start_pixel_x, uint8_t start_pixel_y, uint8_t font);
+int8_t ssd1306_canvas_display(ssd1306_canvas_t *canvas);
+
+#endif // SSD1306_CANVAS_H_
@@ -0,0 +1,154 @@
+#include <avr/io.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_chart.h"
+
+//----------------------------------------------------------------------------------------------------
+// draw one chart column, rows lo to hi (0 = bottom) set, rest cleared
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_chart_column(ssd1306_chart_t *chart, uint8_t seg, uint8_t lo, uint8_t hi)
+	{
+	// convert to display rows
+	uint8_t bottom_y = (uint8_t)((chart->end_page * 8) + 7);
+	uint8_t top_y    = (uint8_t)(bottom_y - hi);
+	uint8_t low_y    = (uint8_t)(bottom_y - lo);
+
+	for (uint8_t i = chart->start_page; i <= chart->end_page; i++)
+		{
+		uint8_t page_top    = (uint8_t)(i * 8);
+		uint8_t page_bottom = (uint8_t)(page_top + 7);
+		uint8_t page_byte   = 0x00;
+
+		// rows of span inside this page
+		if ((top_y <= page_bottom) && (low_y >= page_top))
+			{
+			uint8_t first = (top_y > page_top)    ? (uint8_t)(top_y - page_top) : 0;
+			uint8_t last  = (low_y < page_bottom) ? (uint8_t)(low_y - page_top) : 7;
+			page_byte = (uint8_t)((0xFF << first) & (0xFF >> (7 - last)));
+			}
+
+		SSD1306_BUFFER(chart->dev, i, seg) = page_byte;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// draw sample at column using previous sample for line mode
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_chart_sample(ssd1306_chart_t *chart, uint8_t seg, uint8_t value, uint8_t previous)
+	{
+	switch (chart->mode)
+		{
+		case SSD1306_CHART_LINES:
+			if (previous < value)
+				ssd1306_chart_column(chart, seg, previous, value);
+			else
+				ssd1306_chart_column(chart, seg, value, previous);
+			break;
+
+		case SSD1306_CHART_BARS:
+			ssd1306_chart_column(chart, seg, 0, value);
+			break;
+
+		default:
+			ssd1306_chart_column(chart, seg, value, value);
+			break;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize chart over a page-aligned area, samples holds one byte per column
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_chart_init(ssd1306_chart_t *chart, ssd1306_t *dev, uint8_t *samples,
+		uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg, uint8_t mode, uint8_t scroll)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// check limits
+	if ((start_page > end_page) || (end_page > SSD1306_DEV_PAGE_MAX(dev)))
+		return -1;
+	if ((start_seg >= end_seg) || (end_seg > SSD1306_DEV_SEG_MAX(dev)))
+		return -1;
+
+	chart->dev        = dev;
+	chart->samples    = samples;
+	chart->head       = 0;
+	chart->count      = 0;
+	chart->start_page = start_page;
+	chart->end_page   = end_page;
+	chart->start_seg  = start_seg;
+	chart->end_seg    = end_seg;
+	chart->seg_count  = (uint8_t)((end_seg - start_seg) + 1);
+	chart->y_max      = (uint8_t)((((end_page - start_page) + 1) * 8) - 1);
+	chart->mode       = mode;
+	chart->scroll     = scroll;
+
+	return ssd1306_chart_redraw(chart);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// add sample at right edge, shift chart left one column and update display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_chart_push(ssd1306_chart_t *chart, uint8_t value)
+	{
+	ssd1306_t *dev = chart->dev;
+
+	// clamp and store sample
+	if (value > chart->y_max)
+		value = chart->y_max;
+	uint8_t previous = (chart->count) ? chart->samples[chart->head] : value;
+	if (chart->count)
+		if (++chart->head >= chart->seg_count)
+			chart->head = 0;
+	if (chart->count < chart->seg_count)
+		chart->count++;
+	chart->samples[chart->head] = value;
+
+	// shift chart area left one column, page by page
+	for (uint8_t i = chart->start_page; i <= chart->end_page; i++)
+		memmove(&SSD1306_BUFFER(dev, i, chart->start_seg), &SSD1306_BUFFER(dev, i, chart->start_seg + 1), (size_t)(chart->seg_count - 1));
+
+	// render only the newest column
+	ssd1306_chart_sample(chart, chart->end_seg, value, previous);
+
+	if (chart->scroll == SSD1306_CHART_HWSCROLL)
+		{
+		// let the controller shift its own memory, then send new column
+		uint8_t ssd_cmd[] = {SSD1306_LEFT_CONTENT_SCROLL, 0x00, chart->start_page, 0x01, chart->end_page,
+				chart->start_seg, chart->end_seg};
+		if (ssd1306_send(dev, &ssd_cmd[0], sizeof ssd_cmd, SSD1306_DC_CMD))
+			return -1;
+
+		return ssd1306_display(dev, chart->start_page, chart->end_page, chart->end_seg, chart->end_seg);
+		}
+
+	return ssd1306_display(dev, chart->start_page, chart->end_page, chart->start_seg, chart->end_seg);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// render all stored samples and send chart area to display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_chart_redraw(ssd1306_chart_t *chart)
+	{
+	// clear chart area
+	for (uint8_t i = chart->start_page; i <= chart->end_page; i++)
+		memset(&SSD1306_BUFFER(chart->dev, i, chart->start_seg), 0x00, chart->seg_count);
+
+	// oldest sample goes to the left of the newest
+	uint8_t index    = (uint8_t)((chart->head + chart->seg_count - (chart->count ? chart->count - 1 : 0)) % chart->seg_count);
+	uint8_t seg      = (uint8_t)(chart->end_seg - (chart->count ? chart->count - 1 : 0));
+	uint8_t previous = chart->samples[index];
+	for (uint8_t i = 0; i < chart->count; i++)
+		{
+		uint8_t value = chart->samples[index];
+		ssd1306_chart_sample(chart, seg, value, previous);
+		previous = value;
+		seg++;
+		if (++index >= chart->seg_count)
+			index = 0;
+		}
+
+	return ssd1306_display(chart->dev, chart->start_page, chart->end_page, chart->start_seg, chart->end_seg);
+	}
@@ -0,0 +1,40 @@
+#ifndef SSD1306_CHART_H_
+#define SSD1306_CHART_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// plot modes
+#define SSD1306_CHART_POINTS    0x00
+#define SSD1306_CHART_LINES     0x01
+#define SSD1306_CHART_BARS      0x02
+
+// scroll methods
+#define SSD1306_CHART_SHIFT     0x00 // shift buffer and flush chart window
+#define SSD1306_CHART_HWSCROLL  0x01 // one column content scroll, flush newest column only
+
+// strip chart structure
+typedef struct ssd1306_chart
+	{
+	ssd1306_t *dev;
+	uint8_t   *samples;     // ring buffer, one sample per column
+	uint8_t    head;        // index of newest sample
+	uint8_t    count;       // samples in ring buffer
+	uint8_t    start_page;
+	uint8_t    end_page;
+	uint8_t    start_seg;
+	uint8_t    end_seg;
+	uint8_t    seg_count;
+	uint8_t    y_max;       // largest sample value, plotted at top row
+	uint8_t    mode;
+	uint8_t    scroll;
+	} ssd1306_chart_t;
+
+// prototypes
+int8_t ssd1306_chart_init(ssd1306_chart_t *chart, ssd1306_t *dev, uint8_t *samples,
+		uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg, uint8_t mode, uint8_t scroll);
+int8_t ssd1306_chart_push(ssd1306_chart_t *chart, uint8_t value);
+int8_t ssd1306_chart_redraw(ssd1306_chart_t *chart);
+
+#endif // SSD1306_CHART_H_
@@ -0,0 +1,27 @@
+#ifndef SSD1306_CONFIG_H_
+#define SSD1306_CONFIG_H_
+
+// compile-time display configuration, used when built with -D SSD1306_CONFIG
+// settings left undefined stay runtime values of ssd1306_t
+// ssd1306_init() fails unless its arguments match these settings
+// SSD1306_CONFIG_INIT() needs all settings below defined
+
+// bus, SSD1306_BUS_I2C or SSD1306_BUS_SPI (build with matching SSD1306_I2C or SSD1306_SPI)
+#define SSD1306_CONFIG_BUS       SSD1306_BUS_I2C
+
+// i2c address
+#define SSD1306_CONFIG_ADDR      0x3C
+
+// panel size in pixels
+#define SSD1306_CONFIG_WIDTH     SSD1306_OLED_WIDTH_128
+#define SSD1306_CONFIG_HEIGHT    SSD1306_OLED_HEIGHT_64
+
+// reset and D/C pins for SSD1306_CONFIG_INIT (arduino pin numbers or PIN_NOT_USED)
+#define SSD1306_CONFIG_RESET_PIN PIN_NOT_USED
+#define SSD1306_CONFIG_DC_PIN    PIN_NOT_USED
+
+// skip device valid check in drawing calls, bus calls still check
+// (opt in: drawing on a device that failed or missed init then writes through an unset buffer)
+//#define SSD1306_CONFIG_NO_CHECK
+
+#endif // SSD1306_CONFIG_H_
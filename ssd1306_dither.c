@@ -0,0 +1,109 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_dither.h"
+
+// 4x4 bayer thresholds
+const uint8_t PROGMEM bayer4x4[] =
+		{
+		  8, 136,  40, 168,
+		200,  72, 232, 104,
+		 56, 184,  24, 152,
+		248, 120, 216,  88,
+		};
+
+//----------------------------------------------------------------------------------------------------
+// initialize dither of width pixel scanlines starting at x,y
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_dither_init(ssd1306_dither_t *dither, ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t width,
+		uint8_t mode, int16_t *error)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// check limits
+	if ((start_x > SSD1306_DEV_SEG_MAX(dev)) || (start_y > SSD1306_DEV_HEIGHT(dev)-1) || (width == 0))
+		return -1;
+	if ((mode == SSD1306_DITHER_FS) && (error == NULL))
+		return -1;
+	if (width > (uint8_t)(SSD1306_DEV_WIDTH(dev) - start_x))
+		width = (uint8_t)(SSD1306_DEV_WIDTH(dev) - start_x);
+
+	dither->dev     = dev;
+	dither->error   = error;
+	dither->start_x = start_x;
+	dither->start_y = start_y;
+	dither->width   = width;
+	dither->row     = 0;
+	dither->mode    = mode;
+
+	if (error != NULL)
+		memset(error, 0x00, SSD1306_DITHER_ERROR_SIZE(width) * sizeof error[0]);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// dither one 8-bit grayscale scanline into the device buffer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_dither_row(ssd1306_dither_t *dither, const uint8_t *gray)
+	{
+	ssd1306_t *dev = dither->dev;
+
+	// check limits
+	uint8_t pixel_y = (uint8_t)(dither->start_y + dither->row);
+	if ((pixel_y > SSD1306_DEV_HEIGHT(dev)-1) || (pixel_y < dither->start_y))
+		return -1;
+	dither->row++;
+
+	// determine display page and create bit mask
+	uint8_t pixel_page = pixel_y / 8;
+	uint8_t pixel_bit  = (uint8_t)(1 << (pixel_y % 8));
+	uint8_t *byte      = &SSD1306_BUFFER(dev, pixel_page, dither->start_x);
+
+	if (dither->mode == SSD1306_DITHER_FS)
+		{
+		// error[x+1] holds error carried down to pixel x, errors below are written one pixel behind
+		int16_t *error   = dither->error;
+		int16_t right    = 0;
+		int16_t below_l  = 0;
+		int16_t below    = 0;
+		for (uint8_t x = 0; x < dither->width; x++, byte++)
+			{
+			int16_t value = (int16_t)(gray[x] + right + error[x+1]);
+			if (value >= 128)
+				{
+				*byte |= pixel_bit;
+				value = (int16_t)(value - 255);
+				}
+			else
+				*byte &= (uint8_t)~pixel_bit;
+
+			// distribute 7/16 right, 3/16 below left, 5/16 below, 1/16 below right
+			right        = (int16_t)((value * 7) >> 4);
+			error[x]     = (int16_t)(below_l + ((value * 3) >> 4));
+			below_l      = (int16_t)(below + ((value * 5) >> 4));
+			below        = (int16_t)(value >> 4);
+			}
+		error[dither->width] = below_l;
+		}
+	else
+		{
+		// compare with threshold of row and column in bayer matrix
+		const uint8_t *threshold = &bayer4x4[(pixel_y % 4) * 4];
+		for (uint8_t x = 0; x < dither->width; x++, byte++)
+			{
+			if (gray[x] > pgm_read_byte(&threshold[(dither->start_x + x) % 4]))
+				*byte |= pixel_bit;
+			else
+				*byte &= (uint8_t)~pixel_bit;
+			}
+		}
+
+	ssd1306_dirty_mark(dev, dither->start_x, (uint8_t)(dither->start_x + dither->width - 1), pixel_y, pixel_y);
+
+	return 0;
+	}
@@ -0,0 +1,32 @@
+#ifndef SSD1306_DITHER_H_
+#define SSD1306_DITHER_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// dither modes
+#define SSD1306_DITHER_BAYER 0x00 // 4x4 ordered
+#define SSD1306_DITHER_FS    0x01 // Floyd-Steinberg
+
+// error buffer size for Floyd-Steinberg
+#define SSD1306_DITHER_ERROR_SIZE(width) ((width) + 2)
+
+// scanline dither structure
+typedef struct ssd1306_dither
+	{
+	ssd1306_t *dev;
+	int16_t   *error;   // SSD1306_DITHER_ERROR_SIZE(width) entries, Floyd-Steinberg only
+	uint8_t    start_x;
+	uint8_t    start_y;
+	uint8_t    width;
+	uint8_t    row;     // next scanline
+	uint8_t    mode;
+	} ssd1306_dither_t;
+
+// prototypes
+int8_t ssd1306_dither_init(ssd1306_dither_t *dither, ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t width,
+		uint8_t mode, int16_t *error);
+int8_t ssd1306_dither_row(ssd1306_dither_t *dither, const uint8_t *gray);
+
+#endif // SSD1306_DITHER_H_
@@ -0,0 +1,150 @@
+#include <avr/io.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_gray.h"
+
+//----------------------------------------------------------------------------------------------------
+// initialize grayscale window
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_gray_init(ssd1306_gray_t *gray, ssd1306_t *dev, uint8_t *planes, uint8_t plane_count, uint8_t mode,
+		uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// check limits
+	if ((plane_count < SSD1306_GRAY_PLANES_MIN) || (plane_count > SSD1306_GRAY_PLANES_MAX))
+		return -1;
+	if ((start_page > end_page) || (end_page > SSD1306_DEV_PAGE_MAX(dev)))
+		return -1;
+	if ((start_seg > end_seg) || (end_seg > SSD1306_DEV_SEG_MAX(dev)))
+		return -1;
+
+	gray->dev            = dev;
+	gray->planes         = planes;
+	gray->plane_count    = plane_count;
+	gray->mode           = mode;
+	gray->start_page     = start_page;
+	gray->end_page       = end_page;
+	gray->start_seg      = start_seg;
+	gray->end_seg        = end_seg;
+	gray->page_count     = (uint8_t)((end_page - start_page) + 1);
+	gray->seg_count      = (uint8_t)((end_seg - start_seg) + 1);
+	gray->subframe       = 0;
+	gray->subframe_count = 0;
+
+	// default contrast steps, brightest plane at full contrast
+	for (uint8_t i = 0; i < plane_count; i++)
+		gray->contrast[i] = (uint8_t)(0xFF >> (plane_count - 1 - i));
+
+	ssd1306_gray_clear(gray);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear all planes
+//----------------------------------------------------------------------------------------------------
+void ssd1306_gray_clear(ssd1306_gray_t *gray)
+	{
+	memset(gray->planes, 0x00, SSD1306_GRAY_SIZE((size_t)gray->plane_count, gray->page_count, gray->seg_count));
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set gray level of pixel at x,y (display coordinates)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_gray_pixel_set(ssd1306_gray_t *gray, uint8_t pixel_x, uint8_t pixel_y, uint8_t level)
+	{
+	// check limits
+	uint8_t pixel_page = pixel_y / 8;
+	if ((pixel_x < gray->start_seg) || (pixel_x > gray->end_seg))
+		return -1;
+	if ((pixel_page < gray->start_page) || (pixel_page > gray->end_page))
+		return -1;
+
+	// locate byte in first plane and create bit mask
+	size_t  plane_size = (size_t)gray->page_count * gray->seg_count;
+	size_t  index      = ((size_t)(pixel_page - gray->start_page) * gray->seg_count) + (size_t)(pixel_x - gray->start_seg);
+	uint8_t pixel_bit  = (uint8_t)(1 << (pixel_y % 8));
+
+	// set level bits across planes
+	for (uint8_t i = 0; i < gray->plane_count; i++, index += plane_size)
+		{
+		if (level & (1 << i))
+			gray->planes[index] |= pixel_bit;
+		else
+			gray->planes[index] &= (uint8_t)~pixel_bit;
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set contrast used for a plane in contrast mode
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_gray_contrast_set(ssd1306_gray_t *gray, uint8_t plane, uint8_t contrast)
+	{
+	if (plane >= gray->plane_count)
+		return -1;
+
+	gray->contrast[plane] = contrast;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send next sub-frame to display
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_gray_refresh(ssd1306_gray_t *gray)
+	{
+	ssd1306_t *dev = gray->dev;
+	uint8_t plane;
+
+	// select plane for this sub-frame
+	if (gray->mode == SSD1306_GRAY_CONTRAST)
+		{
+		plane = gray->subframe;
+		if (++gray->subframe >= gray->plane_count)
+			gray->subframe = 0;
+
+		uint8_t ssd_cmd[] = {SSD1306_SETCONTRAST, gray->contrast[plane]};
+		if (ssd1306_send(dev, &ssd_cmd[0], sizeof ssd_cmd, SSD1306_DC_CMD))
+			return -1;
+		}
+	else
+		{
+		// plane n covers sub-frames (2^n - 1) to (2^(n+1) - 2)
+		plane = 0;
+		while ((uint8_t)(gray->subframe + 1) >= (uint8_t)(2 << plane))
+			plane++;
+		if (++gray->subframe >= (uint8_t)((1 << gray->plane_count) - 1))
+			gray->subframe = 0;
+		}
+
+	// window data is contiguous, stream whole plane in one transfer
+	size_t plane_size = (size_t)gray->page_count * gray->seg_count;
+	if (ssd1306_window(dev, gray->start_page, gray->end_page, gray->start_seg, gray->end_seg))
+		return -1;
+	if (ssd1306_send(dev, &gray->planes[plane * plane_size], plane_size, SSD1306_DC_DATA))
+		return -1;
+
+	gray->subframe_count++;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// return sub-frames per second since last call and restart count
+//----------------------------------------------------------------------------------------------------
+uint16_t ssd1306_gray_rate(ssd1306_gray_t *gray, uint16_t elapsed_ms)
+	{
+	uint16_t rate = 0;
+	if (elapsed_ms)
+		rate = (uint16_t)(((uint32_t)gray->subframe_count * 1000) / elapsed_ms);
+
+	gray->subframe_count = 0;
+
+	return rate;
+	}
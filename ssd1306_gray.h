@@ -0,0 +1,46 @@
+#ifndef SSD1306_GRAY_H_
+#define SSD1306_GRAY_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// bitplane limits
+#define SSD1306_GRAY_PLANES_MIN 2
+#define SSD1306_GRAY_PLANES_MAX 4
+
+// sub-frame modulation modes
+#define SSD1306_GRAY_PWM        0x00 // plane n shown for 2^n sub-frames
+#define SSD1306_GRAY_CONTRAST   0x01 // each plane shown once at its own contrast
+
+// grayscale window structure
+typedef struct ssd1306_gray
+	{
+	ssd1306_t *dev;
+	uint8_t   *planes;          // plane_count * page_count * seg_count bytes, page format
+	uint8_t    plane_count;
+	uint8_t    mode;
+	uint8_t    start_page;
+	uint8_t    end_page;
+	uint8_t    start_seg;
+	uint8_t    end_seg;
+	uint8_t    page_count;
+	uint8_t    seg_count;
+	uint8_t    contrast[SSD1306_GRAY_PLANES_MAX];
+	uint8_t    subframe;        // position in modulation cycle
+	uint16_t   subframe_count;  // sub-frames sent since last rate read
+	} ssd1306_gray_t;
+
+// plane buffer size for a window
+#define SSD1306_GRAY_SIZE(planes, pages, segs) ((planes) * (pages) * (segs))
+
+// prototypes
+int8_t   ssd1306_gray_init(ssd1306_gray_t *gray, ssd1306_t *dev, uint8_t *planes, uint8_t plane_count, uint8_t mode,
+		uint8_t start_page, uint8_t end_page, uint8_t start_seg, uint8_t end_seg);
+void     ssd1306_gray_clear(ssd1306_gray_t *gray);
+int8_t   ssd1306_gray_pixel_set(ssd1306_gray_t *gray, uint8_t pixel_x, uint8_t pixel_y, uint8_t level);
+int8_t   ssd1306_gray_contrast_set(ssd1306_gray_t *gray, uint8_t plane, uint8_t contrast);
+int8_t   ssd1306_gray_refresh(ssd1306_gray_t *gray);
+uint16_t ssd1306_gray_rate(ssd1306_gray_t *gray, uint16_t elapsed_ms);
+
+#endif // SSD1306_GRAY_H_
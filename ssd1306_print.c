@@ -0,0 +1,145 @@
+#include <avr/io.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_print.h"
+
+//----------------------------------------------------------------------------------------------------
+// format number into text of width characters, '#' filled when it does not fit, length or -1
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_print_digits(char *text, uint32_t magnitude, uint8_t negative, uint8_t base, uint8_t decimals,
+		uint8_t width, uint8_t flags)
+	{
+	// check limits
+	if ((width > SSD1306_PRINT_WIDTH_MAX) || (decimals > SSD1306_PRINT_DECIMALS_MAX))
+		return -1;
+
+	// convert least significant digit first, 16-bit division once value fits
+	char    digits[SSD1306_PRINT_DECIMALS_MAX + 3];
+	uint8_t count = 0;
+	char    alpha = (flags & SSD1306_PRINT_LOWER) ? 'a' : 'A';
+	do
+		{
+		uint8_t digit;
+		if (magnitude <= 0xFFFF)
+			{
+			uint16_t value16 = (uint16_t)magnitude;
+			digit     = (uint8_t)(value16 % base);
+			magnitude = value16 / base;
+			}
+		else
+			{
+			digit     = (uint8_t)(magnitude % base);
+			magnitude = magnitude / base;
+			}
+		digits[count++] = (char)((digit < 10) ? ('0' + digit) : (alpha + digit - 10));
+
+		// decimal point, at least one integer digit follows
+		if (decimals && (count == decimals))
+			digits[count++] = '.';
+		} while (magnitude || (decimals && (count <= decimals + 1)));
+
+	// natural width unless given
+	uint8_t length = (uint8_t)(count + (negative ? 1 : 0));
+	if (width == 0)
+		width = length;
+
+	uint8_t i = 0;
+	if (length > width)
+		{
+		// value does not fit
+		memset(&text[0], '#', width);
+		i = width;
+		}
+	else
+		{
+		uint8_t pad = (uint8_t)(width - length);
+		if (!(flags & (SSD1306_PRINT_LEFT | SSD1306_PRINT_ZERO)))
+			for (; pad; pad--)
+				text[i++] = ' ';
+		if (negative)
+			text[i++] = '-';
+		if (!(flags & SSD1306_PRINT_LEFT))
+			for (; pad; pad--)
+				text[i++] = '0';
+		while (count)
+			text[i++] = digits[--count];
+		for (; pad; pad--)
+			text[i++] = ' ';
+		}
+	text[i] = '\0';
+
+	return (int8_t)width;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear field of length characters, then draw text
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_print_draw(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font, char *text, int8_t length)
+	{
+	if (length < 0)
+		return -1;
+
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(font, &font_segs, &font_pages);
+	uint16_t end_x = (uint16_t)(start_x + (length * font_segs) - 1);
+	if (end_x > 0xFF)
+		end_x = 0xFF;
+	if (ssd1306_area_fill(dev, start_x, (uint8_t)end_x, start_y, (uint8_t)(start_y + (font_pages * 8) - 1), 0))
+		return -1;
+
+	return ssd1306_text(dev, text, start_x, start_y, font);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// format signed fixed-point decimal, text holds width + 1 characters (SSD1306_PRINT_WIDTH_MAX + 1 when 0)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_print_format(char *text, int32_t value, uint8_t decimals, uint8_t width, uint8_t flags)
+	{
+	uint32_t magnitude = (value < 0) ? (uint32_t)(-(value + 1)) + 1 : (uint32_t)value;
+
+	return ssd1306_print_digits(text, magnitude, (uint8_t)(value < 0), 10, decimals, width, flags);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// print signed decimal
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_print_int(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		int32_t value, uint8_t width, uint8_t flags)
+	{
+	return ssd1306_print_fixed(dev, start_x, start_y, font, value, 0, width, flags);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// print unsigned decimal
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_print_uint(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		uint32_t value, uint8_t width, uint8_t flags)
+	{
+	char text[SSD1306_PRINT_WIDTH_MAX + 1];
+
+	return ssd1306_print_draw(dev, start_x, start_y, font, &text[0], ssd1306_print_digits(&text[0], value, 0, 10, 0, width, flags));
+	}
+
+//----------------------------------------------------------------------------------------------------
+// print signed fixed-point decimal, value is scaled by 10^decimals (1234, 2 prints 12.34)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_print_fixed(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		int32_t value, uint8_t decimals, uint8_t width, uint8_t flags)
+	{
+	char text[SSD1306_PRINT_WIDTH_MAX + 1];
+
+	return ssd1306_print_draw(dev, start_x, start_y, font, &text[0], ssd1306_print_format(&text[0], value, decimals, width, flags));
+	}
+
+//----------------------------------------------------------------------------------------------------
+// print unsigned hexadecimal, zero padding gives fixed digit count
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_print_hex(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		uint32_t value, uint8_t width, uint8_t flags)
+	{
+	char text[SSD1306_PRINT_WIDTH_MAX + 1];
+
+	return ssd1306_print_draw(dev, start_x, start_y, font, &text[0], ssd1306_print_digits(&text[0], value, 0, 16, 0, width, flags));
+	}
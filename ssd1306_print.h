@@ -0,0 +1,29 @@
+#ifndef SSD1306_PRINT_H_
+#define SSD1306_PRINT_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// print flags
+#define SSD1306_PRINT_RIGHT     0x00 // right-aligned, space padded
+#define SSD1306_PRINT_LEFT      0x01 // left-aligned
+#define SSD1306_PRINT_ZERO      0x02 // zero padded after sign, right-aligned only
+#define SSD1306_PRINT_LOWER     0x04 // lower case hex digits
+
+// field size
+#define SSD1306_PRINT_WIDTH_MAX 25   // characters of 5 pixel font across 128 segments
+#define SSD1306_PRINT_DECIMALS_MAX 9
+
+// prototypes
+int8_t ssd1306_print_format(char *text, int32_t value, uint8_t decimals, uint8_t width, uint8_t flags);
+int8_t ssd1306_print_int(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		int32_t value, uint8_t width, uint8_t flags);
+int8_t ssd1306_print_uint(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		uint32_t value, uint8_t width, uint8_t flags);
+int8_t ssd1306_print_fixed(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		int32_t value, uint8_t decimals, uint8_t width, uint8_t flags);
+int8_t ssd1306_print_hex(ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font,
+		uint32_t value, uint8_t width, uint8_t flags);
+
+#endif // SSD1306_PRINT_H_
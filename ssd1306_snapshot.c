@@ -0,0 +1,120 @@
+#include <avr/io.h>
+#include <stdio.h>
+
+#include "ssd1306.h"
+#include "ssd1306_snapshot.h"
+
+//----------------------------------------------------------------------------------------------------
+// write byte as two hex digits
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_snapshot_hex(FILE *out, uint8_t value)
+	{
+	static const char hex_digits[] = "0123456789ABCDEF";
+	fputc(hex_digits[value >> 4], out);
+	fputc(hex_digits[value & 0x0F], out);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// start snapshot, header line "SNAP <width> <height>"
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_snapshot_begin(ssd1306_snapshot_t *snap, ssd1306_t *dev, FILE *out)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	snap->dev  = dev;
+	snap->out  = out;
+	snap->page = 0;
+
+	fputs("SNAP ", out);
+	ssd1306_snapshot_hex(out, SSD1306_DEV_WIDTH(dev));
+	fputc(' ', out);
+	ssd1306_snapshot_hex(out, SSD1306_DEV_HEIGHT(dev));
+	fputc('\n', out);
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send next page packbits encoded, "SNAP P<page> <data> <sum>", return 1 while pages remain
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_snapshot_step(ssd1306_snapshot_t *snap)
+	{
+	ssd1306_t *dev = snap->dev;
+	FILE      *out = snap->out;
+
+	// all pages sent
+	if (snap->page > SSD1306_DEV_PAGE_MAX(dev))
+		return 0;
+
+	uint8_t *row       = &SSD1306_BUFFER(dev, snap->page, 0);
+	uint8_t  seg_count = (uint8_t)(SSD1306_DEV_SEG_MAX(dev) + 1);
+	uint8_t  sum       = 0;
+
+	fputs("SNAP P", out);
+	ssd1306_snapshot_hex(out, snap->page);
+	fputc(' ', out);
+
+	uint16_t i = 0;
+	while (i < seg_count)
+		{
+		// length of run starting here
+		uint16_t run = 1;
+		while ((i + run < seg_count) && (run < SSD1306_SNAPSHOT_RUN_MAX) && (row[i + run] == row[i]))
+			run++;
+
+		if (run >= 3)
+			{
+			// repeat: 257 - count, byte
+			ssd1306_snapshot_hex(out, (uint8_t)(257 - run));
+			ssd1306_snapshot_hex(out, row[i]);
+			for (uint16_t j = 0; j < run; j++)
+				sum = (uint8_t)(sum + row[i]);
+			i = (uint16_t)(i + run);
+			continue;
+			}
+
+		// literal: count - 1, bytes, up to next run of three
+		uint16_t end = i;
+		while ((end < seg_count) && (end - i < SSD1306_SNAPSHOT_RUN_MAX))
+			{
+			if ((end + 2 < seg_count) && (row[end] == row[end + 1]) && (row[end] == row[end + 2]))
+				break;
+			end++;
+			}
+		ssd1306_snapshot_hex(out, (uint8_t)(end - i - 1));
+		for (; i < end; i++)
+			{
+			ssd1306_snapshot_hex(out, row[i]);
+			sum = (uint8_t)(sum + row[i]);
+			}
+		}
+
+	fputc(' ', out);
+	ssd1306_snapshot_hex(out, sum);
+	fputc('\n', out);
+
+	if (++snap->page > SSD1306_DEV_PAGE_MAX(dev))
+		{
+		fputs("SNAP END\n", out);
+		return 0;
+		}
+
+	return 1;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// send whole snapshot (tools/snapshot2png.py)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_snapshot(ssd1306_t *dev, FILE *out)
+	{
+	ssd1306_snapshot_t snap;
+	if (ssd1306_snapshot_begin(&snap, dev, out))
+		return -1;
+
+	while (ssd1306_snapshot_step(&snap))
+		;
+
+	return 0;
+	}
@@ -0,0 +1,25 @@
+#ifndef SSD1306_SNAPSHOT_H_
+#define SSD1306_SNAPSHOT_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ssd1306.h"
+
+// longest packbits run or literal
+#define SSD1306_SNAPSHOT_RUN_MAX 128
+
+// snapshot structure
+typedef struct ssd1306_snapshot
+	{
+	ssd1306_t *dev;
+	FILE      *out;
+	uint8_t    page;           // next page to send
+	} ssd1306_snapshot_t;
+
+// prototypes
+int8_t ssd1306_snapshot_begin(ssd1306_snapshot_t *snap, ssd1306_t *dev, FILE *out);
+int8_t ssd1306_snapshot_step(ssd1306_snapshot_t *snap);
+int8_t ssd1306_snapshot(ssd1306_t *dev, FILE *out);
+
+#endif // SSD1306_SNAPSHOT_H_
@@ -0,0 +1,240 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_sprite.h"
+
+// columns blitted per bitmap call
+#define SSD1306_SPRITE_CHUNK 16
+
+//----------------------------------------------------------------------------------------------------
+// initialize hidden sprite
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_sprite_init(ssd1306_sprite_t *sprite, const uint8_t *bitmap, const uint8_t *mask, uint8_t *save,
+		uint8_t segs, uint8_t pages, uint8_t z)
+	{
+	// check limits
+	if ((segs == 0) || (pages == 0) || (pages > SSD1306_OLED_HEIGHT_MAX / 8))
+		return -1;
+
+	sprite->bitmap  = bitmap;
+	sprite->mask    = mask;
+	sprite->save    = save;
+	sprite->segs    = segs;
+	sprite->pages   = pages;
+	sprite->x       = 0;
+	sprite->y       = 0;
+	sprite->z       = z;
+	sprite->visible = 0;
+	sprite->changed = 0;
+	sprite->drawn   = 0;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// move sprite, shown at next layer update
+//----------------------------------------------------------------------------------------------------
+void ssd1306_sprite_move(ssd1306_sprite_t *sprite, uint8_t x, uint8_t y)
+	{
+	if ((sprite->x != x) || (sprite->y != y))
+		sprite->changed = 1;
+	sprite->x = x;
+	sprite->y = y;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// show or hide sprite, shown at next layer update
+//----------------------------------------------------------------------------------------------------
+void ssd1306_sprite_show(ssd1306_sprite_t *sprite, uint8_t visible)
+	{
+	visible = visible ? 1 : 0;
+	if (sprite->visible != visible)
+		sprite->changed = 1;
+	sprite->visible = visible;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize empty sprite layer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_sprite_layer_init(ssd1306_sprite_layer_t *layer, ssd1306_t *dev)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	layer->dev   = dev;
+	layer->count = 0;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// add sprite to layer, kept in z order
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_sprite_layer_add(ssd1306_sprite_layer_t *layer, ssd1306_sprite_t *sprite)
+	{
+	// check limits
+	if (layer->count >= SSD1306_SPRITES_MAX)
+		return -1;
+
+	// insert after sprites of lower or equal z
+	uint8_t i = layer->count;
+	for (; (i > 0) && (layer->sprites[i-1]->z > sprite->z); i--)
+		layer->sprites[i] = layer->sprites[i-1];
+	layer->sprites[i] = sprite;
+	layer->count++;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// save background under sprite and blit it with its mask
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_sprite_draw(ssd1306_t *dev, ssd1306_sprite_t *sprite)
+	{
+	// off screen
+	if ((sprite->x > SSD1306_DEV_SEG_MAX(dev)) || (sprite->y > SSD1306_DEV_HEIGHT(dev)-1))
+		return 0;
+
+	// covered buffer area
+	uint16_t end_seg  = (uint16_t)(sprite->x + sprite->segs - 1);
+	uint16_t end_page = (uint16_t)((sprite->y + (sprite->pages * 8) - 1) / 8);
+	sprite->save_start_page = sprite->y / 8;
+	sprite->save_end_page   = (end_page > SSD1306_DEV_PAGE_MAX(dev)) ? SSD1306_DEV_PAGE_MAX(dev) : (uint8_t)end_page;
+	sprite->save_start_seg  = sprite->x;
+	sprite->save_end_seg    = (end_seg > SSD1306_DEV_SEG_MAX(dev)) ? SSD1306_DEV_SEG_MAX(dev) : (uint8_t)end_seg;
+
+	// save background
+	uint8_t  seg_count = (uint8_t)((sprite->save_end_seg - sprite->save_start_seg) + 1);
+	uint8_t *save      = sprite->save;
+	for (uint8_t i = sprite->save_start_page; i <= sprite->save_end_page; i++, save += seg_count)
+		memcpy(save, &SSD1306_BUFFER(dev, i, sprite->save_start_seg), seg_count);
+	sprite->drawn = 1;
+
+	// blit from flash in column chunks
+	uint8_t work[SSD1306_SPRITE_CHUNK];
+	uint8_t work_mask[SSD1306_SPRITE_CHUNK];
+	for (uint8_t i = 0; i < sprite->pages; i++)
+		{
+		uint8_t y_pos = (uint8_t)(sprite->y + (i * 8));
+		if ((y_pos < sprite->y) || (y_pos > SSD1306_DEV_HEIGHT(dev)-1))
+			break;
+
+		for (uint8_t x = 0; x < seg_count; x = (uint8_t)(x + SSD1306_SPRITE_CHUNK))
+			{
+			uint8_t count = (uint8_t)(seg_count - x);
+			if (count > SSD1306_SPRITE_CHUNK)
+				count = SSD1306_SPRITE_CHUNK;
+
+			size_t offset = ((size_t)i * sprite->segs) + x;
+			memcpy_P(&work[0], &sprite->bitmap[offset], count);
+			if (sprite->mask != NULL)
+				memcpy_P(&work_mask[0], &sprite->mask[offset], count);
+			else
+				memset(&work_mask[0], 0xFF, count);
+
+			if (ssd1306_bitmap(dev, &work[0], &work_mask[0], count, 1, (uint8_t)(sprite->x + x), y_pos))
+				return -1;
+			}
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// put saved background back
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_sprite_restore(ssd1306_t *dev, ssd1306_sprite_t *sprite)
+	{
+	uint8_t  seg_count = (uint8_t)((sprite->save_end_seg - sprite->save_start_seg) + 1);
+	uint8_t *save      = sprite->save;
+	for (uint8_t i = sprite->save_start_page; i <= sprite->save_end_page; i++, save += seg_count)
+		memcpy(&SSD1306_BUFFER(dev, i, sprite->save_start_seg), save, seg_count);
+	sprite->drawn = 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// redraw sprites and display union of old and new area of each changed sprite
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_sprite_layer_update(ssd1306_sprite_layer_t *layer)
+	{
+	ssd1306_t *dev = layer->dev;
+
+	// nothing changed
+	uint8_t changed = 0;
+	for (uint8_t i = 0; i < layer->count; i++)
+		changed |= layer->sprites[i]->changed;
+	if (!changed)
+		return 0;
+
+	// old areas of changed sprites
+	uint8_t old_area[SSD1306_SPRITES_MAX][4];
+	for (uint8_t i = 0; i < layer->count; i++)
+		{
+		ssd1306_sprite_t *sprite = layer->sprites[i];
+		old_area[i][0] = sprite->drawn ? sprite->save_start_page : 0xFF;
+		old_area[i][1] = sprite->save_end_page;
+		old_area[i][2] = sprite->save_start_seg;
+		old_area[i][3] = sprite->save_end_seg;
+		}
+
+	// sprite drawing leaves dirty spans as they were, changed areas are displayed here
+	uint8_t dirty_lo[SSD1306_OLED_HEIGHT_MAX / 8];
+	uint8_t dirty_hi[SSD1306_OLED_HEIGHT_MAX / 8];
+	memcpy(&dirty_lo[0], &dev->dirty_seg_lo[0], sizeof dirty_lo);
+	memcpy(&dirty_hi[0], &dev->dirty_seg_hi[0], sizeof dirty_hi);
+	uint8_t rop = dev->rop;
+	dev->rop = SSD1306_ROP_COPY;
+
+	// restore top sprite first, then draw bottom sprite first
+	for (uint8_t i = layer->count; i > 0; i--)
+		if (layer->sprites[i-1]->drawn)
+			ssd1306_sprite_restore(dev, layer->sprites[i-1]);
+	int8_t status = 0;
+	for (uint8_t i = 0; (i < layer->count) && (status == 0); i++)
+		if (layer->sprites[i]->visible)
+			status = ssd1306_sprite_draw(dev, layer->sprites[i]);
+
+	dev->rop = rop;
+	memcpy(&dev->dirty_seg_lo[0], &dirty_lo[0], sizeof dirty_lo);
+	memcpy(&dev->dirty_seg_hi[0], &dirty_hi[0], sizeof dirty_hi);
+	if (status)
+		return -1;
+
+	// display union of old and new area
+	for (uint8_t i = 0; i < layer->count; i++)
+		{
+		ssd1306_sprite_t *sprite = layer->sprites[i];
+		if (!sprite->changed)
+			continue;
+		sprite->changed = 0;
+
+		uint8_t *area = &old_area[i][0];
+		if (sprite->drawn)
+			{
+			if (area[0] == 0xFF)
+				{
+				area[0] = sprite->save_start_page;
+				area[1] = sprite->save_end_page;
+				area[2] = sprite->save_start_seg;
+				area[3] = sprite->save_end_seg;
+				}
+			else
+				{
+				if (sprite->save_start_page < area[0]) area[0] = sprite->save_start_page;
+				if (sprite->save_end_page   > area[1]) area[1] = sprite->save_end_page;
+				if (sprite->save_start_seg  < area[2]) area[2] = sprite->save_start_seg;
+				if (sprite->save_end_seg    > area[3]) area[3] = sprite->save_end_seg;
+				}
+			}
+		if (area[0] == 0xFF)
+			continue;
+
+		if (ssd1306_display(dev, area[0], area[1], area[2], area[3]))
+			return -1;
+		}
+
+	return 0;
+	}
@@ -0,0 +1,52 @@
+#ifndef SSD1306_SPRITE_H_
+#define SSD1306_SPRITE_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// sprites per layer
+#define SSD1306_SPRITES_MAX 8
+
+// save-under buffer size, a sprite not on a page boundary covers one more page
+#define SSD1306_SPRITE_SAVE_SIZE(segs, pages) ((segs) * ((pages) + 1))
+
+// sprite structure
+typedef struct ssd1306_sprite
+	{
+	const uint8_t *bitmap;         // PROGMEM page format, segs * pages bytes
+	const uint8_t *mask;           // PROGMEM page format, NULL for opaque sprite
+	uint8_t       *save;           // SSD1306_SPRITE_SAVE_SIZE(segs, pages) bytes
+	uint8_t        segs;
+	uint8_t        pages;
+	uint8_t        x;
+	uint8_t        y;
+	uint8_t        z;              // higher z is drawn on top
+	uint8_t        visible;
+	uint8_t        changed;        // moved or shown/hidden since last update
+	uint8_t        drawn;          // background saved in save area
+	uint8_t        save_start_page;
+	uint8_t        save_end_page;
+	uint8_t        save_start_seg;
+	uint8_t        save_end_seg;
+	} ssd1306_sprite_t;
+
+// sprite layer structure
+typedef struct ssd1306_sprite_layer
+	{
+	ssd1306_t        *dev;
+	ssd1306_sprite_t *sprites[SSD1306_SPRITES_MAX];
+	uint8_t           count;
+	} ssd1306_sprite_layer_t;
+
+// prototypes
+int8_t ssd1306_sprite_init(ssd1306_sprite_t *sprite, const uint8_t *bitmap, const uint8_t *mask, uint8_t *save,
+		uint8_t segs, uint8_t pages, uint8_t z);
+void   ssd1306_sprite_move(ssd1306_sprite_t *sprite, uint8_t x, uint8_t y);
+void   ssd1306_sprite_show(ssd1306_sprite_t *sprite, uint8_t visible);
+
+int8_t ssd1306_sprite_layer_init(ssd1306_sprite_layer_t *layer, ssd1306_t *dev);
+int8_t ssd1306_sprite_layer_add(ssd1306_sprite_layer_t *layer, ssd1306_sprite_t *sprite);
+int8_t ssd1306_sprite_layer_update(ssd1306_sprite_layer_t *layer);
+
+#endif // SSD1306_SPRITE_H_
@@ -0,0 +1,213 @@
+#include <avr/io.h>
+#include <stddef.h>
+
+#include "ssd1306.h"
+#include "ssd1306_stream.h"
+
+//----------------------------------------------------------------------------------------------------
+// initialize stream over ring buffer
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_stream_init(ssd1306_stream_t *stream, ssd1306_t *dev, uint8_t *ring, uint16_t ring_size, uint8_t chunk)
+	{
+	// check for valid device
+	if (dev->valid_flag != DEV_VALID)
+		return -1;
+
+	// check limits
+	if ((ring_size < 2) || (ring_size > 256) || (ring_size & (ring_size - 1)))
+		return -1;
+
+	// a chunk must fit in the ring while the uart keeps writing
+	if ((chunk == 0) || (chunk > ring_size / 2))
+		chunk = (uint8_t)(ring_size / 2);
+
+	stream->dev          = dev;
+	stream->ring         = ring;
+	stream->ring_mask    = (uint8_t)(ring_size - 1);
+	stream->head         = 0;
+	stream->tail         = 0;
+	stream->chunk        = chunk;
+	stream->state        = SSD1306_STREAM_WAIT;
+	stream->header_count = 0;
+	stream->window       = SSD1306_FLUSH_WIN_NONE;
+	stream->remaining    = 0;
+	stream->frames       = 0;
+	stream->overruns     = 0;
+	stream->errors       = 0;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// queue one received byte, safe to call from the uart receive interrupt
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_stream_feed(ssd1306_stream_t *stream, uint8_t byte)
+	{
+	uint8_t head = stream->head;
+	uint8_t next = (uint8_t)((head + 1) & stream->ring_mask);
+
+	// check for full ring
+	if (next == stream->tail)
+		{
+		stream->overruns++;
+		return -1;
+		}
+
+	stream->ring[head] = byte;
+	stream->head       = next;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// consume payload bytes from the ring, end frame when none are left
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_stream_consume(ssd1306_stream_t *stream, uint16_t run)
+	{
+	stream->tail      = (uint8_t)((stream->tail + run) & stream->ring_mask);
+	stream->remaining = (uint16_t)(stream->remaining - run);
+	if (stream->remaining == 0)
+		{
+		if (stream->state == SSD1306_STREAM_PAYLOAD)
+			stream->frames++;
+		stream->state = SSD1306_STREAM_WAIT;
+		}
+	}
+
+//----------------------------------------------------------------------------------------------------
+// drop rest of frame after a failed transfer, payload is skipped so it is not parsed as sync
+//----------------------------------------------------------------------------------------------------
+static void ssd1306_stream_fail(ssd1306_stream_t *stream)
+	{
+	stream->state  = SSD1306_STREAM_SKIP;
+	stream->window = SSD1306_FLUSH_WIN_NONE;
+	stream->errors++;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// parse queued bytes and send payload to the display straight from the ring
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_stream_pump(ssd1306_stream_t *stream)
+	{
+	ssd1306_t *dev = stream->dev;
+
+	for (;;)
+		{
+		uint8_t tail  = stream->tail;
+		uint8_t avail = (uint8_t)((stream->head - tail) & stream->ring_mask);
+		if (avail == 0)
+			return 0;
+
+		// largest contiguous run of payload
+		uint16_t run = avail;
+		if (run > (uint16_t)(stream->ring_mask - tail + 1))
+			run = (uint16_t)(stream->ring_mask - tail + 1);
+
+		if (stream->state == SSD1306_STREAM_SKIP)
+			{
+			if (run > stream->remaining)
+				run = stream->remaining;
+			ssd1306_stream_consume(stream, run);
+			continue;
+			}
+
+		if (stream->state == SSD1306_STREAM_PAYLOAD)
+			{
+			uint8_t end_page  = stream->header[1];
+			uint8_t start_seg = stream->header[2];
+			uint8_t end_seg   = stream->header[3];
+			uint8_t page      = stream->page;
+			uint8_t seg       = stream->seg;
+
+			// set window again after other transfers, a partly sent row gets a window of its own
+			if (dev->window_owner != stream)
+				stream->window = SSD1306_FLUSH_WIN_NONE;
+			uint8_t window = stream->window;
+			if (window == SSD1306_FLUSH_WIN_NONE)
+				window = (seg == start_seg) ? SSD1306_FLUSH_WIN_AREA : SSD1306_FLUSH_WIN_ROW;
+
+			// wait for a full chunk unless it ends the frame, the row window or the ring
+			uint16_t limit = stream->remaining;
+			if (window == SSD1306_FLUSH_WIN_ROW)
+				limit = (uint16_t)((end_seg - seg) + 1);
+			if (run > limit)
+				run = limit;
+			if ((run < stream->chunk) && (run < limit) && ((uint16_t)(tail + run) <= stream->ring_mask))
+				return 0;
+
+			int8_t result = 0;
+			if (stream->window == SSD1306_FLUSH_WIN_NONE)
+				{
+				if (window == SSD1306_FLUSH_WIN_AREA)
+					result = ssd1306_window(dev, page, end_page, start_seg, end_seg);
+				else
+					result = ssd1306_window(dev, page, page, seg, end_seg);
+				}
+			if (result == 0)
+				result = ssd1306_send(dev, &stream->ring[tail], run, SSD1306_DC_DATA);
+
+			// release ring space only after the transfer, drop rest of frame on error
+			if (result)
+				{
+				ssd1306_stream_fail(stream);
+				ssd1306_stream_consume(stream, run);
+				return -1;
+				}
+			ssd1306_stream_consume(stream, run);
+			dev->window_owner = stream;
+			stream->window    = window;
+
+			// advance position
+			uint16_t offset = (uint16_t)((seg - start_seg) + run);
+			uint16_t row    = (uint16_t)((end_seg - start_seg) + 1);
+			stream->page = (uint8_t)(page + (offset / row));
+			stream->seg  = (uint8_t)(start_seg + (offset % row));
+			if ((window == SSD1306_FLUSH_WIN_ROW) && (stream->seg == start_seg))
+				stream->window = SSD1306_FLUSH_WIN_NONE;
+			continue;
+			}
+
+		uint8_t byte = stream->ring[tail];
+		stream->tail = (uint8_t)((tail + 1) & stream->ring_mask);
+
+		if (stream->state == SSD1306_STREAM_WAIT)
+			{
+			if (byte == SSD1306_STREAM_SYNC)
+				{
+				stream->state        = SSD1306_STREAM_HEADER;
+				stream->header_count = 0;
+				}
+			continue;
+			}
+
+		stream->header[stream->header_count++] = byte;
+		if (stream->header_count < sizeof stream->header)
+			continue;
+
+		// check window limits, resynchronize on bad header
+		uint8_t start_page = stream->header[0];
+		uint8_t end_page   = stream->header[1];
+		uint8_t start_seg  = stream->header[2];
+		uint8_t end_seg    = stream->header[3];
+		if ((start_page > end_page) || (end_page > SSD1306_DEV_PAGE_MAX(dev)) ||
+				(start_seg > end_seg) || (end_seg > SSD1306_DEV_SEG_MAX(dev)))
+			{
+			stream->state = SSD1306_STREAM_WAIT;
+			stream->errors++;
+			continue;
+			}
+
+		// payload follows only once the window is set, otherwise it is dropped
+		stream->remaining = (uint16_t)((end_page - start_page + 1) * (end_seg - start_seg + 1));
+		stream->page      = start_page;
+		stream->seg       = start_seg;
+		if (ssd1306_window(dev, start_page, end_page, start_seg, end_seg))
+			{
+			ssd1306_stream_fail(stream);
+			return -1;
+			}
+		dev->window_owner = stream;
+		stream->window    = SSD1306_FLUSH_WIN_AREA;
+		stream->state     = SSD1306_STREAM_PAYLOAD;
+		}
+	}
@@ -0,0 +1,43 @@
+#ifndef SSD1306_STREAM_H_
+#define SSD1306_STREAM_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// frame format: sync, start page, end page, start seg, end seg, page-format payload
+#define SSD1306_STREAM_SYNC    0xA5
+
+// parser states
+#define SSD1306_STREAM_WAIT    0x00 // waiting for sync byte
+#define SSD1306_STREAM_HEADER  0x01 // collecting window
+#define SSD1306_STREAM_PAYLOAD 0x02 // forwarding payload
+#define SSD1306_STREAM_SKIP    0x03 // dropping rest of payload after error
+
+// uart to display stream structure, display_buffer is not touched
+typedef struct ssd1306_stream
+	{
+	ssd1306_t        *dev;
+	uint8_t          *ring;       // power of two size, 2 to 256 bytes
+	uint8_t           ring_mask;
+	volatile uint8_t  head;       // written by ssd1306_stream_feed
+	volatile uint8_t  tail;       // read by ssd1306_stream_pump
+	uint8_t           chunk;      // smallest payload transfer before end of frame
+	uint8_t           state;
+	uint8_t           header_count;
+	uint8_t           header[4];  // start page, end page, start seg, end seg
+	uint8_t           window;     // display window still set for payload, SSD1306_FLUSH_WIN_*
+	uint8_t           page;       // next payload byte
+	uint8_t           seg;
+	uint16_t          remaining;  // payload bytes left in frame
+	uint16_t          frames;
+	uint16_t          overruns;   // bytes dropped on full ring
+	uint16_t          errors;     // frames dropped on bad window or failed transfer
+	} ssd1306_stream_t;
+
+// prototypes
+int8_t ssd1306_stream_init(ssd1306_stream_t *stream, ssd1306_t *dev, uint8_t *ring, uint16_t ring_size, uint8_t chunk);
+int8_t ssd1306_stream_feed(ssd1306_stream_t *stream, uint8_t byte);
+int8_t ssd1306_stream_pump(ssd1306_stream_t *stream);
+
+#endif // SSD1306_STREAM_H_
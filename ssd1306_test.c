@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <util/delay.h>
 
 #include "uart.h"
 
@@ -14,6 +15,16 @@
 #include "spi.h"
 
 #include "ssd1306.h"
+#include "ssd1306_gray.h"
+#include "ssd1306_widget.h"
+#include "ssd1306_chart.h"
+#include "ssd1306_textbox.h"
+#include "ssd1306_dither.h"
+#include "ssd1306_stream.h"
+#include "ssd1306_anim.h"
+#include "ssd1306_print.h"
+#include "ssd1306_sprite.h"
+#include "ssd1306_snapshot.h"
 
 #define SSD1306_SLAVE_ADDR          0x3C
 
@@ -29,6 +40,26 @@ uint8_t bitmap_test[][32] =
 	},
 	};
 
+// 12x10 arrow, row-major MSB first (PBM P4 layout)
+uint8_t bitmap_rowmajor_test[] =
+	{
+	0x06, 0x00, 0x07, 0x00, 0x07, 0x80, 0xFF, 0xC0, 0xFF, 0xE0,
+	0xFF, 0xE0, 0xFF, 0xC0, 0x07, 0x80, 0x07, 0x00, 0x06, 0x00,
+	};
+
+// 8x8 blinking square, keyframe and xor deltas (tools/anim_encode.py format)
+const uint8_t PROGMEM anim_test[] =
+	{
+	0x08, 0x01, 0x02, 0x00, 0xFA, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x02, 0x05, 0x03, 0x3C, 0x3C, 0x3C, 0x3C,
+	0x00, 0x00, 0x02, 0x05, 0x03, 0x3C, 0x3C, 0x3C, 0x3C,
+	};
+
+// 8x8 ball sprite with outline mask, page format
+const uint8_t PROGMEM sprite_ball[] = {0x3C, 0x42, 0x99, 0xBD, 0xBD, 0x99, 0x42, 0x3C};
+const uint8_t PROGMEM sprite_ball_mask[] = {0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C};
+
 
 int main(void)
 	{
@@ -162,6 +193,24 @@ int main(void)
 #endif
 	option = getchar();
 
+	// pixel batch test
+	printf("\npixel batch test\n");
+	ssd1306_clear(&dev_i2c);
+	ssd1306_point_t points[64];
+	for (uint8_t i = 0; i < 64; i++)
+		{
+		points[i].x = (uint8_t)(rand() % 128);
+		points[i].y = (uint8_t)(rand() % 64);
+		}
+	ssd1306_pixels_set(&dev_i2c, points, 64, 1);
+#ifdef SSD1306_SPI
+	ssd1306_display(&dev_spi, 0, dev_spi.oled_page_max, 0, dev_spi.oled_seg_max);
+#endif
+#ifdef SSD1306_I2C
+	ssd1306_display_dirty(&dev_i2c);
+#endif
+	option = getchar();
+
 	// bitmap test
 	printf("\nbitmap test 1\n");
 	ssd1306_clear_buffer();
@@ -190,6 +239,18 @@ int main(void)
 #endif
 	option = getchar();
 
+	// row-major bitmap test
+	printf("\nrow-major bitmap test\n");
+	ssd1306_clear_buffer();
+	ssd1306_bitmap_rowmajor(&dev_i2c, bitmap_rowmajor_test, NULL, 12, 10, 58, 27, SSD1306_ROWMAJOR_MSB);
+#ifdef SSD1306_SPI
+	ssd1306_display(&dev_spi, 0, dev_spi.oled_page_max, 0, dev_spi.oled_seg_max);
+#endif
+#ifdef SSD1306_I2C
+	ssd1306_display(&dev_i2c, 0, dev_i2c.oled_page_max, 0, dev_i2c.oled_seg_max);
+#endif
+	option = getchar();
+
 	char text1[16];
 	ssd1306_clear_buffer();
 	printf("\ntext test 1\n");
@@ -216,6 +277,134 @@ int main(void)
 #endif
 	option = getchar();
 
+	printf("\nframe commit test\n");
+	ssd1306_clear_buffer();
+	for (uint8_t i = 0; i < 100; i++)
+		{
+		// one display call per label, sent as merged windows at commit
+		ssd1306_frame_begin(&dev_i2c);
+		ssd1306_print_uint(&dev_i2c, 0, 0, SSD1306_FONT_5X7, i, 3, SSD1306_PRINT_RIGHT);
+		ssd1306_display(&dev_i2c, 0, 0, 0, 17);
+		ssd1306_print_uint(&dev_i2c, 24, 0, SSD1306_FONT_5X7, (uint8_t)(99 - i), 3, SSD1306_PRINT_RIGHT);
+		ssd1306_display(&dev_i2c, 0, 0, 24, 41);
+		ssd1306_print_uint(&dev_i2c, 0, 8, SSD1306_FONT_5X7, (uint8_t)(i * 2), 3, SSD1306_PRINT_RIGHT);
+		ssd1306_display(&dev_i2c, 1, 1, 0, 17);
+		ssd1306_frame_commit(&dev_i2c);
+		}
+	option = getchar();
+
+	printf("\nscaled text test\n");
+	ssd1306_clear(&dev_i2c);
+	ssd1306_text_scaled(&dev_i2c, "42", 0, 0, SSD1306_FONT_5X7, 4);
+	ssd1306_text_scaled(&dev_i2c, "7.5", 48, 0, SSD1306_FONT_6X14, 2);
+	ssd1306_text_scaled(&dev_i2c, "V", 48, 32, SSD1306_FONT_5X7, 3);
+	ssd1306_display_dirty(&dev_i2c);
+	option = getchar();
+
+	printf("\nprint test\n");
+	ssd1306_clear(&dev_i2c);
+	for (int16_t i = -50; i <= 50; i++)
+		{
+		ssd1306_print_int(&dev_i2c, 0, 0, SSD1306_FONT_6X14, i, 5, SSD1306_PRINT_RIGHT);
+		ssd1306_print_fixed(&dev_i2c, 0, 16, SSD1306_FONT_6X14, (int32_t)i * 25, 2, 7, SSD1306_PRINT_ZERO);
+		ssd1306_print_hex(&dev_i2c, 0, 32, SSD1306_FONT_5X7, (uint32_t)(uint16_t)i, 4, SSD1306_PRINT_ZERO);
+		ssd1306_print_uint(&dev_i2c, 0, 40, SSD1306_FONT_5X7, (uint32_t)(i + 50), 3, SSD1306_PRINT_LEFT);
+		ssd1306_display_dirty(&dev_i2c);
+		}
+	option = getchar();
+
+#ifdef SSD1306_GLYPH_CACHE
+	printf("\nglyph cache test\n");
+	ssd1306_clear(&dev_i2c);
+	ssd1306_glyph_cache_clear();
+	for (uint8_t i = 0; i < 100; i++)
+		{
+		// labels off page boundaries reuse the same shifted glyphs
+		ssd1306_print_uint(&dev_i2c, 4, 3, SSD1306_FONT_5X7, i, 3, SSD1306_PRINT_RIGHT);
+		ssd1306_print_uint(&dev_i2c, 4, 21, SSD1306_FONT_5X7, (uint8_t)(99 - i), 3, SSD1306_PRINT_RIGHT);
+		ssd1306_display_dirty(&dev_i2c);
+		}
+	uint16_t cache_hits, cache_misses;
+	ssd1306_glyph_cache_stats(&cache_hits, &cache_misses);
+	printf("hits %u misses %u\n", cache_hits, cache_misses);
+	option = getchar();
+
+#endif
+	printf("\nflush step test\n");
+	ssd1306_clear_buffer();
+	ssd1306_area_set(&dev_i2c, 0, 127, 0, 63, 1);
+	ssd1306_dirty_clear(&dev_i2c);
+	ssd1306_flush_start(&dev_i2c, 0, dev_i2c.oled_page_max, 0, dev_i2c.oled_seg_max);
+	for (uint16_t i = 0; ssd1306_flush_step(&dev_i2c, 64) == 1; i++)
+		{
+		// other main loop work between steps
+		ssd1306_print_uint(&dev_i2c, 0, 0, SSD1306_FONT_5X7, i, 3, SSD1306_PRINT_RIGHT);
+		ssd1306_flush_dirty(&dev_i2c);
+		}
+	option = getchar();
+
+	printf("\nraster op test\n");
+	ssd1306_rop_set(&dev_i2c, SSD1306_ROP_XOR);
+	for (uint8_t i = 0; i < 10; i++)
+		{
+		ssd1306_area_set(&dev_i2c, 40, 45, 40, 53, 1);
+		ssd1306_display_dirty(&dev_i2c);
+		_delay_ms(250);
+		}
+	ssd1306_rop_set(&dev_i2c, SSD1306_ROP_INVERT);
+	ssd1306_area_set(&dev_i2c, 0, 127, 48, 63, 1);
+	ssd1306_display_dirty(&dev_i2c);
+	ssd1306_rop_set(&dev_i2c, SSD1306_ROP_COPY);
+	option = getchar();
+
+	printf("\nsprite test\n");
+	uint8_t sprite_save[2][SSD1306_SPRITE_SAVE_SIZE(8, 1)];
+	ssd1306_sprite_t sprites[2];
+	ssd1306_sprite_layer_t sprite_layer;
+	ssd1306_sprite_layer_init(&sprite_layer, &dev_i2c);
+	ssd1306_sprite_init(&sprites[0], sprite_ball, sprite_ball_mask, sprite_save[0], 8, 1, 0);
+	ssd1306_sprite_init(&sprites[1], sprite_ball, sprite_ball_mask, sprite_save[1], 8, 1, 1);
+	ssd1306_sprite_layer_add(&sprite_layer, &sprites[0]);
+	ssd1306_sprite_layer_add(&sprite_layer, &sprites[1]);
+	ssd1306_sprite_show(&sprites[0], 1);
+	ssd1306_sprite_show(&sprites[1], 1);
+	for (uint8_t i = 0; i < 120; i++)
+		{
+		// balls cross over the text, background comes back behind them
+		ssd1306_sprite_move(&sprites[0], i, (uint8_t)(10 + (i % 40)));
+		ssd1306_sprite_move(&sprites[1], (uint8_t)(119 - i), (uint8_t)(50 - (i % 40)));
+		ssd1306_sprite_layer_update(&sprite_layer);
+		_delay_ms(20);
+		}
+	ssd1306_sprite_show(&sprites[0], 0);
+	ssd1306_sprite_show(&sprites[1], 0);
+	ssd1306_sprite_layer_update(&sprite_layer);
+	option = getchar();
+
+	printf("\nsnapshot test\n");
+	ssd1306_snapshot_t snapshot;
+	ssd1306_snapshot_begin(&snapshot, &dev_i2c, stdout);
+	for (uint8_t i = 0; ssd1306_snapshot_step(&snapshot); i++)
+		{
+		// one page per pass, display keeps updating meanwhile
+		ssd1306_print_uint(&dev_i2c, 0, 0, SSD1306_FONT_5X7, i, 3, SSD1306_PRINT_RIGHT);
+		ssd1306_display_dirty(&dev_i2c);
+		}
+	option = getchar();
+
+	printf("\ntext box test\n");
+	ssd1306_clear_buffer();
+	ssd1306_textbox_line_t textbox_lines[16];
+	ssd1306_textbox_t textbox;
+	ssd1306_textbox_init(&textbox, &dev_i2c, 16, 111, 8, 55, SSD1306_FONT_5X7, SSD1306_ALIGN_CENTER, textbox_lines, 16);
+	ssd1306_textbox_set(&textbox, "The quick brown fox jumps over the lazy dog.\nPack my box with five dozen liquor jugs.");
+	for (uint16_t i = 0; i + 48 <= ssd1306_textbox_height(&textbox); i++)
+		{
+		ssd1306_textbox_render(&textbox, i);
+		ssd1306_display(&dev_i2c, 1, 6, 16, 111);
+		}
+	option = getchar();
+
 	printf("\narea test\n");
 	ssd1306_clear_buffer();
 	ssd1306_area_set(&dev_i2c, 32, 96, 16, 48, 1);
@@ -227,6 +416,90 @@ int main(void)
 #endif
 	option = getchar();
 
+	printf("\nwidget test\n");
+	ssd1306_clear_buffer();
+	ssd1306_bar_t   bar;
+	ssd1306_gauge_t gauge;
+	ssd1306_field_t field;
+	ssd1306_bar_init(&bar, &dev_i2c, 0, 101, 0, 9, SSD1306_WIDGET_HORIZONTAL, 100);
+	ssd1306_gauge_init(&gauge, &dev_i2c, 0, 101, 16, 23, SSD1306_WIDGET_HORIZONTAL, 4, 100);
+	ssd1306_field_init(&field, &dev_i2c, 0, 32, SSD1306_FONT_6X14, 4);
+	ssd1306_display(&dev_i2c, 0, dev_i2c.oled_page_max, 0, dev_i2c.oled_seg_max);
+	ssd1306_dirty_clear(&dev_i2c);
+	for (uint16_t i = 0; i <= 100; i++)
+		{
+		ssd1306_bar_set(&bar, i);
+		ssd1306_gauge_set(&gauge, i);
+		ssd1306_field_set(&field, (int32_t)i);
+		ssd1306_display_dirty(&dev_i2c);
+		}
+	option = getchar();
+
+	printf("\nchart test\n");
+	ssd1306_clear_buffer();
+	static uint8_t chart_samples[128];
+	ssd1306_chart_t chart;
+	ssd1306_chart_init(&chart, &dev_i2c, chart_samples, 2, 7, 0, 127, SSD1306_CHART_LINES, SSD1306_CHART_SHIFT);
+	for (int i = 0; i < 256; i++)
+		ssd1306_chart_push(&chart, (uint8_t)(abs((i % 94) - 47)));
+	option = getchar();
+
+	printf("\ndither test\n");
+	ssd1306_clear_buffer();
+	uint8_t dither_gray[128];
+	static int16_t dither_error[SSD1306_DITHER_ERROR_SIZE(128)];
+	ssd1306_dither_t dither;
+	for (uint8_t x = 0; x < 128; x++)
+		dither_gray[x] = (uint8_t)(x * 2);
+	ssd1306_dither_init(&dither, &dev_i2c, 0, 0, 128, SSD1306_DITHER_BAYER, NULL);
+	for (uint8_t y = 0; y < 32; y++)
+		ssd1306_dither_row(&dither, dither_gray);
+	ssd1306_dither_init(&dither, &dev_i2c, 0, 32, 128, SSD1306_DITHER_FS, dither_error);
+	for (uint8_t y = 0; y < 32; y++)
+		ssd1306_dither_row(&dither, dither_gray);
+	ssd1306_display_dirty(&dev_i2c);
+	option = getchar();
+
+	printf("\nstream test, send frames with tools/stream_frames.py then press any key\n");
+	static uint8_t stream_ring[128];
+	ssd1306_stream_t stream;
+	ssd1306_stream_init(&stream, &dev_i2c, stream_ring, sizeof stream_ring, 32);
+	while (stream.frames < 1)
+		{
+		ssd1306_stream_feed(&stream, (uint8_t)getchar());
+		ssd1306_stream_pump(&stream);
+		}
+	option = getchar();
+
+	printf("\nanimation test\n");
+	ssd1306_clear_buffer();
+	ssd1306_anim_t anim;
+	ssd1306_anim_init(&anim, &dev_i2c, anim_test, 3, 60);
+	for (uint8_t i = 0; i < 20; i++)
+		{
+		ssd1306_anim_step(&anim);
+		_delay_ms(250);
+		}
+	option = getchar();
+
+	printf("\ngrayscale test\n");
+	ssd1306_clear_buffer();
+	static uint8_t gray_planes[SSD1306_GRAY_SIZE(2, 2, 64)];
+	ssd1306_gray_t gray;
+#ifdef SSD1306_SPI
+	ssd1306_display(&dev_spi, 0, dev_spi.oled_page_max, 0, dev_spi.oled_seg_max);
+	ssd1306_gray_init(&gray, &dev_spi, gray_planes, 2, SSD1306_GRAY_PWM, 3, 4, 32, 95);
+#else
+	ssd1306_display(&dev_i2c, 0, dev_i2c.oled_page_max, 0, dev_i2c.oled_seg_max);
+	ssd1306_gray_init(&gray, &dev_i2c, gray_planes, 2, SSD1306_GRAY_PWM, 3, 4, 32, 95);
+#endif
+	for (uint8_t x = 32; x < 96; x++)
+		for (uint8_t y = 24; y < 40; y++)
+			ssd1306_gray_pixel_set(&gray, x, y, (uint8_t)((x - 32) / 16));
+	for (int i = 0; i < 600; i++)
+		ssd1306_gray_refresh(&gray);
+	option = getchar();
+
 	printf("\nend program\n");
 	ssd1306_clear_buffer();
 #ifdef SSD1306_SPI
@@ -0,0 +1,232 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_textbox.h"
+
+//----------------------------------------------------------------------------------------------------
+// draw glyph with rows outside the box clipped, glyph_y may be above the box
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_textbox_glyph(ssd1306_textbox_t *box, uint16_t codepoint, uint8_t x, int16_t glyph_y)
+	{
+	const ssd1306_font_t *font = ssd1306_font_get(box->font);
+	uint8_t font_segs  = font->segs;
+	uint8_t font_pages = font->pages;
+	uint8_t font_bytes = (uint8_t)(font_segs * font_pages);
+
+	// get character font bytes from flash
+	uint8_t glyph[font_bytes];
+	memcpy_P(&glyph[0], ssd1306_font_glyph(font, codepoint), font_bytes);
+
+	// first visible row and number of rows dropped above the box
+	uint8_t draw_y = (glyph_y < box->start_y) ? box->start_y : (uint8_t)glyph_y;
+	uint8_t drop   = (uint8_t)(draw_y - glyph_y);
+	uint8_t rows   = (uint8_t)((box->end_y - draw_y) + 1);
+
+	// shift columns up and mask rows below the box (fonts are at most two pages)
+	uint8_t work[font_bytes];
+	uint8_t mask[font_bytes];
+	for (uint8_t x_seg = 0; x_seg < font_segs; x_seg++)
+		{
+		uint16_t column = glyph[x_seg];
+		if (font_pages > 1)
+			column |= (uint16_t)(glyph[x_seg + font_segs] << 8);
+		column >>= drop;
+		if (rows < 16)
+			column &= (uint16_t)((1 << rows) - 1);
+
+		for (uint8_t i = 0; i < font_pages; i++)
+			{
+			work[x_seg + (i * font_segs)] = (uint8_t)(column >> (i * 8));
+			mask[x_seg + (i * font_segs)] = (uint8_t)(column >> (i * 8));
+			}
+		}
+
+	return ssd1306_bitmap(box->dev, &work[0], &mask[0], font_segs, font_pages, x, draw_y);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize text box, lines holds line_max cached line breaks
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_textbox_init(ssd1306_textbox_t *box, ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t font, uint8_t align, ssd1306_textbox_line_t *lines, uint8_t line_max)
+	{
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(font, &font_segs, &font_pages);
+
+	// check limits, box must hold at least one character
+	if ((end_x > SSD1306_DEV_SEG_MAX(dev)) || (end_y > SSD1306_DEV_HEIGHT(dev)-1))
+		return -1;
+	if ((end_x < start_x) || ((end_x - start_x) + 1 < font_segs) || (end_y < start_y))
+		return -1;
+
+	box->dev        = dev;
+	box->start_x    = start_x;
+	box->end_x      = end_x;
+	box->start_y    = start_y;
+	box->end_y      = end_y;
+	box->font       = font;
+	box->align      = align;
+	box->text       = NULL;
+	box->lines      = lines;
+	box->line_max   = line_max;
+	box->line_count = 0;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// set text and compute line breaks (word wrap and newlines)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_textbox_set(ssd1306_textbox_t *box, const char *text)
+	{
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(box->font, &font_segs, &font_pages);
+	uint8_t line_chars = (uint8_t)(((box->end_x - box->start_x) + 1) / font_segs);
+
+	box->text       = text;
+	box->line_count = 0;
+
+	uint16_t pos     = 0;
+	uint8_t  wrapped = 0;
+	while (text[pos] != '\0')
+		{
+		if (box->line_count >= box->line_max)
+			return -1;
+
+		// skip the space a wrap broke at, keep indentation after newlines
+		if (wrapped)
+			pos++;
+		wrapped = 0;
+
+		// find end of line, remember last break opportunity and its length in characters
+		uint16_t start        = pos;
+		uint16_t break_pos    = 0;
+		uint8_t  break_length = 0;
+		uint8_t  length       = 0;
+		uint8_t  indent       = 1;
+		while ((text[pos] != '\0') && (text[pos] != '\n'))
+			{
+			// utf-8 continuation bytes belong to the previous character
+			if ((text[pos] & 0xC0) == 0x80)
+				{
+				pos++;
+				continue;
+				}
+
+			// no break opportunity inside indentation, cap it so a character still fits
+			if (text[pos] == ' ')
+				{
+				if (indent && (length >= line_chars - 1))
+					{
+					start++;
+					pos++;
+					continue;
+					}
+				if (!indent)
+					{
+					break_pos    = pos;
+					break_length = length;
+					}
+				}
+			else if (length >= line_chars)
+				{
+				// wrap at last space, hard break long words
+				if (break_pos > start)
+					{
+					pos     = break_pos;
+					length  = break_length;
+					wrapped = 1;
+					}
+				break;
+				}
+			else
+				indent = 0;
+			pos++;
+			length++;
+			}
+
+		// drop trailing spaces
+		uint16_t end = pos;
+		while ((end > start) && (text[end-1] == ' '))
+			{
+			end--;
+			length--;
+			}
+		if (length > line_chars)
+			length = line_chars;
+
+		box->lines[box->line_count].start  = start;
+		box->lines[box->line_count].length = length;
+		box->line_count++;
+
+		if (text[pos] == '\n')
+			pos++;
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// clear box and render cached lines scrolled up by offset_y pixels
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_textbox_render(ssd1306_textbox_t *box, uint16_t offset_y)
+	{
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(box->font, &font_segs, &font_pages);
+	uint8_t line_height = (uint8_t)(font_pages * 8);
+	uint8_t box_width   = (uint8_t)((box->end_x - box->start_x) + 1);
+
+	// clear box
+	if (ssd1306_area_fill(box->dev, box->start_x, box->end_x, box->start_y, box->end_y, 0))
+		return -1;
+	if (box->text == NULL)
+		return 0;
+
+	// first line touching the box
+	uint8_t first = (uint8_t)(offset_y / line_height);
+	for (uint8_t i = first; i < box->line_count; i++)
+		{
+		int16_t line_y = (int16_t)((box->start_y + (i * line_height)) - (int16_t)offset_y);
+		if (line_y > box->end_y)
+			break;
+
+		// align line
+		ssd1306_textbox_line_t *line = &box->lines[i];
+		uint8_t line_width = (uint8_t)(line->length * font_segs);
+		uint8_t x = box->start_x;
+		if (box->align == SSD1306_ALIGN_CENTER)
+			x = (uint8_t)(x + ((box_width - line_width) / 2));
+		else if (box->align == SSD1306_ALIGN_RIGHT)
+			x = (uint8_t)(x + (box_width - line_width));
+
+		// draw line glyphs
+		const char *text = &box->text[line->start];
+		for (uint8_t j = 0; j < line->length; j++, x = (uint8_t)(x + font_segs))
+			{
+			uint16_t codepoint = ssd1306_utf8_next(&text);
+			if (codepoint == ' ')
+				continue;
+			if (ssd1306_textbox_glyph(box, codepoint, x, line_y))
+				return -1;
+			}
+		}
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// height of laid out text in pixels
+//----------------------------------------------------------------------------------------------------
+uint16_t ssd1306_textbox_height(ssd1306_textbox_t *box)
+	{
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(box->font, &font_segs, &font_pages);
+
+	return (uint16_t)(box->line_count * font_pages * 8);
+	}
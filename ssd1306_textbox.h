@@ -0,0 +1,43 @@
+#ifndef SSD1306_TEXTBOX_H_
+#define SSD1306_TEXTBOX_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// text alignment
+#define SSD1306_ALIGN_LEFT   0x00
+#define SSD1306_ALIGN_CENTER 0x01
+#define SSD1306_ALIGN_RIGHT  0x02
+
+// cached line break
+typedef struct ssd1306_textbox_line
+	{
+	uint16_t start;  // byte offset of first character in text
+	uint8_t  length; // utf-8 characters in line, trailing spaces dropped
+	} ssd1306_textbox_line_t;
+
+// text box structure
+typedef struct ssd1306_textbox
+	{
+	ssd1306_t              *dev;
+	uint8_t                 start_x;
+	uint8_t                 end_x;
+	uint8_t                 start_y;
+	uint8_t                 end_y;
+	uint8_t                 font;
+	uint8_t                 align;
+	const char             *text;       // text the cached layout belongs to
+	ssd1306_textbox_line_t *lines;      // line break cache
+	uint8_t                 line_max;
+	uint8_t                 line_count;
+	} ssd1306_textbox_t;
+
+// prototypes
+int8_t   ssd1306_textbox_init(ssd1306_textbox_t *box, ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t font, uint8_t align, ssd1306_textbox_line_t *lines, uint8_t line_max);
+int8_t   ssd1306_textbox_set(ssd1306_textbox_t *box, const char *text);
+int8_t   ssd1306_textbox_render(ssd1306_textbox_t *box, uint16_t offset_y);
+uint16_t ssd1306_textbox_height(ssd1306_textbox_t *box);
+
+#endif // SSD1306_TEXTBOX_H_
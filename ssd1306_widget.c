@@ -0,0 +1,234 @@
+#include <avr/io.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_print.h"
+#include "ssd1306_widget.h"
+
+//----------------------------------------------------------------------------------------------------
+// set pixels from offset "from" up to offset "to" along a widget track
+//----------------------------------------------------------------------------------------------------
+static int8_t ssd1306_widget_span(ssd1306_t *dev, uint8_t orient, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t from, uint8_t to, uint8_t pixel_value)
+	{
+	if (from >= to)
+		return 0;
+
+	// horizontal tracks grow to the right, vertical tracks grow upwards
+	if (orient == SSD1306_WIDGET_VERTICAL)
+		return ssd1306_area_fill(dev, start_x, end_x, (uint8_t)(end_y - (to - 1)), (uint8_t)(end_y - from), pixel_value);
+
+	return ssd1306_area_fill(dev, (uint8_t)(start_x + from), (uint8_t)(start_x + (to - 1)), start_y, end_y, pixel_value);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// length of a widget track in pixels
+//----------------------------------------------------------------------------------------------------
+static uint8_t ssd1306_widget_length(uint8_t orient, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y)
+	{
+	if (orient == SSD1306_WIDGET_VERTICAL)
+		return (uint8_t)((end_y - start_y) + 1);
+
+	return (uint8_t)((end_x - start_x) + 1);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// scale value to pixels
+//----------------------------------------------------------------------------------------------------
+static uint8_t ssd1306_widget_scale(uint16_t value, uint16_t max, uint8_t length)
+	{
+	if (value >= max)
+		return length;
+
+	return (uint8_t)(((uint32_t)value * length) / max);
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize bar and draw border (area includes border)
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_bar_init(ssd1306_bar_t *bar, ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t orient, uint16_t max)
+	{
+	// check limits, interior must be at least one pixel
+	if ((end_x < start_x + 2) || (end_y < start_y + 2) || (max == 0))
+		return -1;
+	if ((end_x > SSD1306_DEV_SEG_MAX(dev)) || (end_y > SSD1306_DEV_HEIGHT(dev)-1))
+		return -1;
+
+	bar->dev     = dev;
+	bar->start_x = (uint8_t)(start_x + 1);
+	bar->end_x   = (uint8_t)(end_x - 1);
+	bar->start_y = (uint8_t)(start_y + 1);
+	bar->end_y   = (uint8_t)(end_y - 1);
+	bar->orient  = orient;
+	bar->fill    = 0;
+	bar->max     = max;
+
+	// draw border and empty interior
+	if (ssd1306_area_fill(dev, start_x, end_x, start_y, end_y, 1))
+		return -1;
+	if (ssd1306_area_fill(dev, bar->start_x, bar->end_x, bar->start_y, bar->end_y, 0))
+		return -1;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// update bar, only changed pixels are drawn
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_bar_set(ssd1306_bar_t *bar, uint16_t value)
+	{
+	uint8_t length = ssd1306_widget_length(bar->orient, bar->start_x, bar->end_x, bar->start_y, bar->end_y);
+	uint8_t fill   = ssd1306_widget_scale(value, bar->max, length);
+
+	// grow or shrink fill
+	if (fill > bar->fill)
+		{
+		if (ssd1306_widget_span(bar->dev, bar->orient, bar->start_x, bar->end_x, bar->start_y, bar->end_y, bar->fill, fill, 1))
+			return -1;
+		}
+	else
+		{
+		if (ssd1306_widget_span(bar->dev, bar->orient, bar->start_x, bar->end_x, bar->start_y, bar->end_y, fill, bar->fill, 0))
+			return -1;
+		}
+
+	bar->fill = fill;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize gauge and draw marker at zero
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_gauge_init(ssd1306_gauge_t *gauge, ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t orient, uint8_t marker_size, uint16_t max)
+	{
+	// check limits
+	if ((end_x < start_x) || (end_y < start_y) || (max == 0) || (marker_size == 0))
+		return -1;
+	if ((end_x > SSD1306_DEV_SEG_MAX(dev)) || (end_y > SSD1306_DEV_HEIGHT(dev)-1))
+		return -1;
+	if (marker_size > ssd1306_widget_length(orient, start_x, end_x, start_y, end_y))
+		return -1;
+
+	gauge->dev         = dev;
+	gauge->start_x     = start_x;
+	gauge->end_x       = end_x;
+	gauge->start_y     = start_y;
+	gauge->end_y       = end_y;
+	gauge->orient      = orient;
+	gauge->marker_size = marker_size;
+	gauge->pos         = 0;
+	gauge->max         = max;
+
+	// clear track and draw marker
+	if (ssd1306_area_fill(dev, start_x, end_x, start_y, end_y, 0))
+		return -1;
+	if (ssd1306_widget_span(dev, orient, start_x, end_x, start_y, end_y, 0, marker_size, 1))
+		return -1;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// move gauge marker, only uncovered and newly covered pixels are drawn
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_gauge_set(ssd1306_gauge_t *gauge, uint16_t value)
+	{
+	uint8_t length = ssd1306_widget_length(gauge->orient, gauge->start_x, gauge->end_x, gauge->start_y, gauge->end_y);
+	uint8_t pos    = ssd1306_widget_scale(value, gauge->max, (uint8_t)(length - gauge->marker_size));
+	if (pos == gauge->pos)
+		return 0;
+
+	// old and new marker spans, drop the overlap
+	uint8_t clear_from = gauge->pos;
+	uint8_t clear_to   = (uint8_t)(gauge->pos + gauge->marker_size);
+	uint8_t set_from   = pos;
+	uint8_t set_to     = (uint8_t)(pos + gauge->marker_size);
+	if (pos > gauge->pos)
+		{
+		if (clear_to > set_from) clear_to = set_from;
+		if (set_from < (uint8_t)(gauge->pos + gauge->marker_size)) set_from = (uint8_t)(gauge->pos + gauge->marker_size);
+		}
+	else
+		{
+		if (clear_from < set_to) clear_from = set_to;
+		if (set_to > gauge->pos) set_to = gauge->pos;
+		}
+
+	if (ssd1306_widget_span(gauge->dev, gauge->orient, gauge->start_x, gauge->end_x, gauge->start_y, gauge->end_y,
+			clear_from, clear_to, 0))
+		return -1;
+	if (ssd1306_widget_span(gauge->dev, gauge->orient, gauge->start_x, gauge->end_x, gauge->start_y, gauge->end_y,
+			set_from, set_to, 1))
+		return -1;
+
+	gauge->pos = pos;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// initialize numeric field and clear its area
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_field_init(ssd1306_field_t *field, ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font, uint8_t chars)
+	{
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(font, &font_segs, &font_pages);
+
+	// check limits
+	if ((chars == 0) || (chars > SSD1306_FIELD_CHARS_MAX))
+		return -1;
+
+	field->dev     = dev;
+	field->start_x = start_x;
+	field->start_y = start_y;
+	field->font    = font;
+	field->chars   = chars;
+	memset(&field->text[0], ' ', chars);
+	field->text[chars] = '\0';
+
+	// clear field area
+	if (ssd1306_area_fill(dev, start_x, (uint8_t)(start_x + (chars * font_segs) - 1),
+			start_y, (uint8_t)(start_y + (font_pages * 8) - 1), 0))
+		return -1;
+
+	return 0;
+	}
+
+//----------------------------------------------------------------------------------------------------
+// update numeric field, only changed characters are drawn
+//----------------------------------------------------------------------------------------------------
+int8_t ssd1306_field_set(ssd1306_field_t *field, int32_t value)
+	{
+	uint8_t font_segs;
+	uint8_t font_pages;
+	ssd1306_font_info(field->font, &font_segs, &font_pages);
+
+	// format value right-aligned, '#' filled when it does not fit
+	char text[SSD1306_FIELD_CHARS_MAX + 1];
+	if (ssd1306_print_format(&text[0], value, 0, field->chars, SSD1306_PRINT_RIGHT) < 0)
+		return -1;
+
+	// redraw changed characters
+	for (uint8_t j = 0; j < field->chars; j++)
+		{
+		if (text[j] == field->text[j])
+			continue;
+
+		uint8_t x = (uint8_t)(field->start_x + (j * font_segs));
+		if (ssd1306_area_fill(field->dev, x, (uint8_t)(x + font_segs - 1),
+				field->start_y, (uint8_t)(field->start_y + (font_pages * 8) - 1), 0))
+			return -1;
+
+		char glyph[2] = {text[j], '\0'};
+		if ((glyph[0] != ' ') && ssd1306_text(field->dev, &glyph[0], x, field->start_y, field->font))
+			return -1;
+
+		field->text[j] = text[j];
+		}
+
+	return 0;
+	}
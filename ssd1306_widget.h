@@ -0,0 +1,65 @@
+#ifndef SSD1306_WIDGET_H_
+#define SSD1306_WIDGET_H_
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// widget orientation
+#define SSD1306_WIDGET_HORIZONTAL 0x00 // fills/moves left to right
+#define SSD1306_WIDGET_VERTICAL   0x01 // fills/moves bottom to top
+
+// numeric field size
+#define SSD1306_FIELD_CHARS_MAX   11   // sign and 10 digits of int32_t
+
+// progress bar / bar gauge structure
+typedef struct ssd1306_bar
+	{
+	ssd1306_t *dev;
+	uint8_t    start_x;     // interior area, inside border
+	uint8_t    end_x;
+	uint8_t    start_y;
+	uint8_t    end_y;
+	uint8_t    orient;
+	uint8_t    fill;        // rendered fill length in pixels
+	uint16_t   max;
+	} ssd1306_bar_t;
+
+// marker gauge structure
+typedef struct ssd1306_gauge
+	{
+	ssd1306_t *dev;
+	uint8_t    start_x;     // marker track
+	uint8_t    end_x;
+	uint8_t    start_y;
+	uint8_t    end_y;
+	uint8_t    orient;
+	uint8_t    marker_size; // marker length along track in pixels
+	uint8_t    pos;         // rendered marker offset along track
+	uint16_t   max;
+	} ssd1306_gauge_t;
+
+// right-aligned numeric field structure
+typedef struct ssd1306_field
+	{
+	ssd1306_t *dev;
+	uint8_t    start_x;
+	uint8_t    start_y;
+	uint8_t    font;
+	uint8_t    chars;
+	char       text[SSD1306_FIELD_CHARS_MAX + 1]; // rendered characters
+	} ssd1306_field_t;
+
+// prototypes
+int8_t ssd1306_bar_init(ssd1306_bar_t *bar, ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t orient, uint16_t max);
+int8_t ssd1306_bar_set(ssd1306_bar_t *bar, uint16_t value);
+
+int8_t ssd1306_gauge_init(ssd1306_gauge_t *gauge, ssd1306_t *dev, uint8_t start_x, uint8_t end_x, uint8_t start_y, uint8_t end_y,
+		uint8_t orient, uint8_t marker_size, uint16_t max);
+int8_t ssd1306_gauge_set(ssd1306_gauge_t *gauge, uint16_t value);
+
+int8_t ssd1306_field_init(ssd1306_field_t *field, ssd1306_t *dev, uint8_t start_x, uint8_t start_y, uint8_t font, uint8_t chars);
+int8_t ssd1306_field_set(ssd1306_field_t *field, int32_t value);
+
+#endif // SSD1306_WIDGET_H_
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Encode a sequence of PBM/XBM frames as an ssd1306_anim PROGMEM array.
+
+The first frame is stored as a delta from a blank area (the keyframe),
+every later frame as the XOR against the previous one, limited to the
+window of changed bytes and run-length coded:
+
+    token 0x00-0x7F   xor the next token + 1 bytes
+    token 0x80-0xFF   skip (token & 0x7F) + 1 unchanged bytes
+
+With --loop a delta from the last frame back to the keyframe is appended
+so ssd1306_anim_step() can repeat the animation without a full redraw.
+
+    anim_encode.py --fps 12 --loop -n spinner spinner_*.pbm > spinner.h
+"""
+
+import argparse
+import sys
+
+from pbm2ssd1306 import read_pbm, read_xbm, to_pages
+
+LOOP = 0x01
+EMPTY = 0xFF
+SKIP = 0x80
+RUN_MAX = 128
+
+
+def load(path, invert):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if path.lower().endswith('.xbm'):
+        width, height, rows = read_xbm(data.decode())
+    else:
+        width, height, rows = read_pbm(data)
+    pages, out = to_pages(width, height, rows, invert)
+    return width, pages, out
+
+
+def runs(values):
+    """Split window bytes into (xor, bytes) runs, keeping short zero gaps in literals."""
+    out = []
+    i = 0
+    while i < len(values):
+        j = i
+        if values[i] == 0:
+            while j < len(values) and values[j] == 0:
+                j += 1
+            if out and out[-1][0] and j - i <= 2 and j < len(values):
+                out[-1][1].extend(values[i:j])
+            else:
+                out.append((False, values[i:j]))
+        else:
+            while j < len(values) and values[j] != 0:
+                j += 1
+            if out and out[-1][0]:
+                out[-1][1].extend(values[i:j])
+            else:
+                out.append((True, list(values[i:j])))
+        i = j
+    return out
+
+
+def encode(prev, cur, segs, pages):
+    """Return delta bytes that turn prev into cur."""
+    diff = [a ^ b for a, b in zip(prev, cur)]
+    changed = [i for i, v in enumerate(diff) if v]
+    if not changed:
+        return [EMPTY]
+    start_page, end_page = changed[0] // segs, changed[-1] // segs
+    columns = [i % segs for i in changed]
+    start_seg, end_seg = min(columns), max(columns)
+    window = []
+    for page in range(start_page, end_page + 1):
+        window += diff[page * segs + start_seg:page * segs + end_seg + 1]
+
+    out = [start_page, end_page, start_seg, end_seg]
+    for literal, values in runs(window):
+        for k in range(0, len(values), RUN_MAX):
+            part = values[k:k + RUN_MAX]
+            if literal:
+                out.append(len(part) - 1)
+                out += part
+            else:
+                out.append(SKIP | (len(part) - 1))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('images', nargs='+', help='input .pbm or .xbm frames')
+    parser.add_argument('-n', '--name', default='anim', help='C array name')
+    parser.add_argument('--fps', type=float, default=10, help='frame rate')
+    parser.add_argument('--loop', action='store_true', help='append delta back to keyframe')
+    parser.add_argument('-i', '--invert', action='store_true', help='invert pixels')
+    args = parser.parse_args()
+
+    frames = [load(path, args.invert) for path in args.images]
+    segs, pages = frames[0][0], frames[0][1]
+    if any(f[0] != segs or f[1] != pages for f in frames):
+        sys.exit('all frames must have the same size')
+    if segs > 128 or pages > 8:
+        sys.exit('frames larger than 128x64')
+
+    period = int(round(1000 / args.fps))
+    data = [segs, pages, len(frames) & 0xFF, len(frames) >> 8, period & 0xFF, period >> 8, LOOP if args.loop else 0]
+    deltas = []
+    prev = [0] * (segs * pages)
+    for _, _, cur in frames:
+        deltas.append(encode(prev, cur, segs, pages))
+        prev = cur
+    if args.loop:
+        deltas.append(encode(prev, frames[0][2], segs, pages))
+
+    name = args.name
+    w = sys.stdout.write
+    w('// generated by anim_encode.py, %d frames %dx%d at %d ms\n' % (len(frames), segs, pages * 8, period))
+    w('const uint8_t PROGMEM %s[] =\n\t{\n' % name)
+    w('\t' + ', '.join('0x%02X' % b for b in data) + ',\n')
+    for i, delta in enumerate(deltas):
+        label = 'loop' if i == len(frames) else 'frame %d' % i
+        w('\t// %s\n' % label)
+        for k in range(0, len(delta), 16):
+            w('\t' + ', '.join('0x%02X' % b for b in delta[k:k + 16]) + ',\n')
+    w('\t};\n')
+
+    total = len(data) + sum(len(d) for d in deltas)
+    sys.stderr.write('%d bytes, %d as full frames\n' % (total, len(frames) * segs * pages))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Build a sparse ssd1306 font holding only the glyphs a set of strings uses.
+
+Glyphs come from a BDF font or from a dense page-format C header such as
+font5x7.h. The output defines the glyph data and sorted codepoint index in
+PROGMEM plus an ssd1306_font_t descriptor for ssd1306_text_font().
+
+    fontsubset.py --bdf 6x13.bdf --text-file strings_de.txt -n font_de
+    fontsubset.py --header font5x7.h --segs 5 --pages 1 --cp437 --text "25°C µs" -n font_small
+"""
+
+import argparse
+import re
+import sys
+
+
+def read_bdf(path):
+    """Return (segs, pages, {codepoint: [column bytes, page major]})."""
+    glyphs = {}
+    cell_w = cell_h = ascent = None
+    with open(path, encoding='latin-1') as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        if line.startswith('FONTBOUNDINGBOX'):
+            cell_w, cell_h, _, y_off = (int(v) for v in line.split()[1:5])
+            ascent = cell_h + y_off
+        elif line.startswith('FONT_ASCENT'):
+            ascent = int(line.split()[1])
+        elif line.startswith('STARTCHAR'):
+            code, bbx, rows = None, None, []
+            for line in lines:
+                if line.startswith('ENCODING'):
+                    code = int(line.split()[1])
+                elif line.startswith('BBX'):
+                    bbx = [int(v) for v in line.split()[1:5]]
+                elif line.startswith('BITMAP'):
+                    for line in lines:
+                        if line.startswith('ENDCHAR'):
+                            break
+                        rows.append((int(line, 16), len(line) * 4))
+                    break
+            if code is None or code < 0 or bbx is None:
+                continue
+            width, height, x_off, y_off = bbx
+            pixels = set()
+            top = ascent - (y_off + height)
+            for r, (bits, row_bits) in enumerate(rows):
+                for c in range(width):
+                    if bits & (1 << (row_bits - 1 - c)):
+                        pixels.add((x_off + c, top + r))
+            glyphs[code] = pixels
+
+    pages = (cell_h + 7) // 8
+    out = {}
+    for code, pixels in glyphs.items():
+        data = []
+        for page in range(pages):
+            for x in range(cell_w):
+                byte = 0
+                for bit in range(8):
+                    if (x, page * 8 + bit) in pixels:
+                        byte |= 1 << bit
+                data.append(byte)
+        out[code] = data
+    return cell_w, pages, out
+
+
+def read_header(path, segs, pages, cp437):
+    """Return (segs, pages, {codepoint: bytes}) from a dense C font table."""
+    text = open(path).read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    body = text[text.index('{') + 1:text.index('}')]
+    body = re.sub(r'//[^\n]*', '', body)
+    values = [int(v, 16) for v in re.findall(r'0[xX][0-9a-fA-F]+', body)]
+    size = segs * pages
+    out = {}
+    for index in range(len(values) // size):
+        code = index
+        if cp437 and index >= 0x80:
+            # font5x7 lacks glyph 0xB2, later glyphs sit one index lower
+            code = ord(bytes([index + 1 if index >= 0xB2 else index]).decode('cp437'))
+        out.setdefault(code, values[index * size:(index + 1) * size])
+    return segs, pages, out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--bdf', help='BDF font file')
+    source.add_argument('--header', help='dense page-format C font header')
+    parser.add_argument('--segs', type=int, help='glyph width of header font')
+    parser.add_argument('--pages', type=int, help='glyph pages of header font')
+    parser.add_argument('--cp437', action='store_true', help='header glyphs above 0x7F are code page 437')
+    parser.add_argument('--text', action='append', default=[], help='string to cover')
+    parser.add_argument('--text-file', action='append', default=[], help='UTF-8 file of strings to cover')
+    parser.add_argument('--ascii', action='store_true', help='keep printable ASCII as a direct range')
+    parser.add_argument('-n', '--name', default='font_subset', help='C name of font')
+    args = parser.parse_args()
+
+    if args.bdf:
+        segs, pages, glyphs = read_bdf(args.bdf)
+    else:
+        if not args.segs or not args.pages:
+            parser.error('--header needs --segs and --pages')
+        segs, pages, glyphs = read_header(args.header, args.segs, args.pages, args.cp437)
+
+    used = set('?')
+    for s in args.text:
+        used.update(s)
+    for path in args.text_file:
+        used.update(open(path, encoding='utf-8').read())
+    used = {ord(ch) for ch in used if ch not in '\r\n' and ord(ch) <= 0xFFFF}
+
+    first, direct = 0, 0
+    if args.ascii:
+        first, direct = 0x20, 0x5F
+        used -= set(range(first, first + direct))
+
+    missing = sorted(cp for cp in used if cp not in glyphs)
+    for cp in missing:
+        sys.stderr.write('warning: no glyph for U+%04X\n' % cp)
+    sparse = sorted(cp for cp in used if cp in glyphs)
+
+    blank = [0] * (segs * pages)
+    table = [glyphs.get(cp, blank) for cp in range(first, first + direct)]
+    table += [glyphs[cp] for cp in sparse]
+    order = list(range(first, first + direct)) + sparse
+    fallback = order.index(ord('?')) if ord('?') in order else 0
+
+    name = args.name
+    w = sys.stdout.write
+    w('// generated by fontsubset.py\n')
+    w('#include <avr/pgmspace.h>\n\n#include "ssd1306.h"\n\n')
+    w('const uint8_t PROGMEM %s_glyphs[] = {\n' % name)
+    for cp, data in zip(order, table):
+        label = chr(cp) if cp >= 0x20 else ''
+        w('  ' + ','.join('0x%02X' % b for b in data) + ',  // U+%04X %s\n' % (cp, label))
+    w('};\n\n')
+    codepoints = 'NULL'
+    if sparse:
+        w('const uint16_t PROGMEM %s_codepoints[] = {\n' % name)
+        for i in range(0, len(sparse), 8):
+            w('  ' + ', '.join('0x%04X' % cp for cp in sparse[i:i + 8]) + ',\n')
+        w('};\n\n')
+        codepoints = '&%s_codepoints[0]' % name
+    w('const ssd1306_font_t %s =\n\t\t{&%s_glyphs[0], %s, NULL, 0x%02X, %d, %d, %d, %d, %d};\n'
+      % (name, name, codepoints, first, direct, len(sparse), fallback, segs, pages))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Convert PBM (P1/P4) or XBM images to ssd1306 page-format C arrays.
+
+The default RAM array can be passed straight to ssd1306_bitmap() with the
+generated *_SEGS and *_PAGES sizes, so no transpose is needed on the target.
+
+With --progmem the array goes to flash. ssd1306_bitmap() reads RAM, so
+either use it as a sprite bitmap (ssd1306_sprite_init() reads flash) or
+copy it with memcpy_P() into a RAM buffer first.
+"""
+
+import argparse
+import re
+import sys
+
+
+def read_pbm(data):
+    """Return (width, height, rows) where rows[y][x] is 0 or 1."""
+    pos = 0
+
+    def next_token():
+        nonlocal pos
+        while True:
+            while pos < len(data) and data[pos:pos + 1].isspace():
+                pos += 1
+            if data[pos:pos + 1] == b'#':
+                while pos < len(data) and data[pos:pos + 1] not in (b'\n', b'\r'):
+                    pos += 1
+                continue
+            break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        return data[start:pos]
+
+    magic = next_token()
+    width = int(next_token())
+    height = int(next_token())
+
+    if magic == b'P4':
+        pos += 1
+        row_bytes = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * row_bytes:pos + (y + 1) * row_bytes]
+            rows.append([(line[x // 8] >> (7 - (x % 8))) & 1 for x in range(width)])
+        return width, height, rows
+
+    if magic == b'P1':
+        bits = []
+        while len(bits) < width * height:
+            tok = next_token()
+            if not tok:
+                break
+            bits.extend(int(ch) for ch in tok.decode())
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+
+    raise ValueError('unsupported PBM format %r' % magic)
+
+
+def read_xbm(text):
+    """Return (width, height, rows) from XBM source text."""
+    width = int(re.search(r'_width\s+(\d+)', text).group(1))
+    height = int(re.search(r'_height\s+(\d+)', text).group(1))
+    body = text[text.index('{') + 1:text.rindex('}')]
+    values = [int(v, 16) for v in re.findall(r'0[xX][0-9a-fA-F]+', body)]
+    row_bytes = (width + 7) // 8
+    rows = []
+    for y in range(height):
+        line = values[y * row_bytes:(y + 1) * row_bytes]
+        rows.append([(line[x // 8] >> (x % 8)) & 1 for x in range(width)])
+    return width, height, rows
+
+
+def to_pages(width, height, rows, invert=False):
+    """Transpose pixel rows into page-major column bytes."""
+    pages = (height + 7) // 8
+    out = []
+    for page in range(pages):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and (rows[y][x] ^ invert):
+                    byte |= 1 << bit
+            out.append(byte)
+    return pages, out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('image', help='input .pbm or .xbm file')
+    parser.add_argument('-n', '--name', default='bitmap', help='C array name')
+    parser.add_argument('-i', '--invert', action='store_true', help='invert pixels')
+    parser.add_argument('-p', '--progmem', action='store_true', help='place array in PROGMEM (not for ssd1306_bitmap() directly)')
+    args = parser.parse_args()
+
+    with open(args.image, 'rb') as f:
+        data = f.read()
+    if args.image.lower().endswith('.xbm'):
+        width, height, rows = read_xbm(data.decode())
+    else:
+        width, height, rows = read_pbm(data)
+
+    pages, out = to_pages(width, height, rows, args.invert)
+    name = args.name
+    w = sys.stdout.write
+    w('// generated by pbm2ssd1306.py from %s\n' % args.image)
+    w('#define %s_SEGS  %d\n' % (name.upper(), width))
+    w('#define %s_PAGES %d\n' % (name.upper(), pages))
+    if args.progmem:
+        w('// flash data: ssd1306_sprite_init(), or memcpy_P() to RAM before ssd1306_bitmap()\n')
+    w('%s %s[] =\n\t{\n' % ('const uint8_t PROGMEM' if args.progmem else 'uint8_t', name))
+    for i in range(0, len(out), 16):
+        w('\t' + ', '.join('0x%02X' % b for b in out[i:i + 16]) + ',\n')
+    w('\t};\n')
+
+
+if __name__ == '__main__':
+    main()
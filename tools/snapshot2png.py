@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Decode ssd1306_snapshot() output captured from the UART into PNG.
+
+The firmware prints, between its other output,
+
+    SNAP 80 40                  width and height (hex)
+    SNAP P00 8100 00            page 0: packbits data, byte sum
+    ...
+    SNAP END
+
+Packbits control byte n: 0..127 copies the next n+1 bytes, 129..255
+repeats the next byte 257-n times. Every complete snapshot in the log is
+written; with more than one, an index is added before the extension.
+
+    cat /dev/ttyUSB0 | tee uart.log
+    snapshot2png.py uart.log -o shot.png --scale 4
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+
+def unpack(data):
+    out = []
+    i = 0
+    while i < len(data):
+        n = data[i]
+        i += 1
+        if n < 128:
+            out.extend(data[i:i + n + 1])
+            i += n + 1
+        elif n > 128:
+            out.extend([data[i]] * (257 - n))
+            i += 1
+    return out
+
+
+def parse(lines):
+    """Yield (width, height, pages) for each complete snapshot."""
+    width = height = None
+    pages = {}
+    for number, line in enumerate(lines, 1):
+        fields = line.split()
+        if len(fields) < 2 or fields[0] != 'SNAP':
+            continue
+        try:
+            if len(fields) == 3 and not fields[1].startswith('P'):
+                width, height = int(fields[1], 16), int(fields[2], 16)
+                pages = {}
+            elif fields[1] == 'END' and width is not None:
+                missing = [p for p in range(height // 8) if p not in pages]
+                if missing:
+                    sys.stderr.write('line %d: snapshot missing pages %s\n' % (number, missing))
+                else:
+                    yield width, height, pages
+                width = None
+            elif fields[1].startswith('P') and width is not None:
+                if len(fields) != 4:
+                    raise ValueError
+                row = unpack(bytes.fromhex(fields[2]))
+                if len(row) != width or sum(row) & 0xFF != int(fields[3], 16):
+                    raise ValueError
+                pages[int(fields[1][1:], 16)] = row
+        except (ValueError, IndexError):
+            sys.stderr.write('line %d: corrupt snapshot line skipped\n' % number)
+
+
+def write_png(path, width, height, pages, scale, invert):
+    raw = bytearray()
+    for y in range(height * scale):
+        line = bytearray([0])
+        for x in range(width):
+            on = (pages[y // scale // 8][x] >> (y // scale % 8)) & 1
+            line.extend([0 if on == invert else 255] * scale)
+        raw.extend(line)
+
+    def chunk(kind, data):
+        body = kind + data
+        return struct.pack('>I', len(data)) + body + struct.pack('>I', zlib.crc32(body))
+
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width * scale, height * scale, 8, 0, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(bytes(raw), 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('log', nargs='?', help='captured UART output (default stdin)')
+    parser.add_argument('-o', '--output', default='snapshot.png')
+    parser.add_argument('--scale', type=int, default=1, help='pixel size in output image')
+    parser.add_argument('--invert', action='store_true', help='dark pixels on light background')
+    args = parser.parse_args()
+
+    lines = open(args.log, errors='replace') if args.log else sys.stdin
+    shots = list(parse(lines))
+    if not shots:
+        sys.exit('no complete snapshot found')
+
+    base, ext = os.path.splitext(args.output)
+    for index, (width, height, pages) in enumerate(shots):
+        path = args.output if len(shots) == 1 else '%s-%d%s' % (base, index, ext)
+        write_png(path, width, height, pages, args.scale, args.invert)
+        sys.stderr.write('%s: %dx%d\n' % (path, width, height))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""Host-side SSD1306 model fed with the byte stream sent by ssd1306_send().
+
+Input is the log printed by firmware built with SSD1306_WIRE_LOG
+(`make wirelog`): one transfer per line, led by the i2c address of the
+panel (00 on spi),
+
+    C 3C 22 00 07 21 00 7F  command transfer
+    D 3C 00 FF 81 ...       data transfer
+    B 3C 3 00 FF 81 ...     buffer page 3 (ssd1306_wire_log_buffer)
+
+Commands and data are decoded into a virtual 128x64 GDDRAM per address, so
+logs of multi-panel canvases split by panel. At each block of B lines the
+emulated display memory of that panel is compared with the logged buffer.
+Wire bytes and wire time are counted over all panels on the given bus.
+"""
+
+import argparse
+import sys
+
+WIDTH = 128
+PAGES = 8
+
+# number of argument bytes for multi-byte commands
+ARGS = {
+    0x81: 1, 0x8D: 1, 0xA8: 1, 0xD3: 1, 0xD5: 1, 0xD9: 1, 0xDA: 1, 0xDB: 1,
+    0x20: 1, 0x21: 2, 0x22: 2, 0xA3: 2,
+    0x26: 6, 0x27: 6, 0x29: 5, 0x2A: 5, 0x2C: 6, 0x2D: 6,
+}
+
+MODE_HORIZONTAL = 0
+MODE_VERTICAL = 1
+MODE_PAGE = 2
+
+
+class SSD1306:
+    """Virtual SSD1306 display memory and address state."""
+
+    def __init__(self):
+        self.ram = [[0] * WIDTH for _ in range(PAGES)]
+        self.mode = MODE_PAGE
+        self.col_start, self.col_end = 0, WIDTH - 1
+        self.page_start, self.page_end = 0, PAGES - 1
+        self.col, self.page = 0, 0
+        self.start_line = 0
+        self.multiplex = 63
+        self.contrast = 0x7F
+        self.seg_remap = False
+        self.com_scan_dec = False
+        self.inverted = False
+        self.display_on = False
+        self.all_on = False
+        self.scroll_active = False
+        self.commands = 0
+        self.data_bytes = 0
+        self._cmd = []
+
+    # command stream -------------------------------------------------------
+
+    def command(self, data):
+        for byte in data:
+            self._cmd.append(byte)
+            need = ARGS.get(self._cmd[0], 0)
+            if len(self._cmd) > need:
+                self._execute(self._cmd)
+                self._cmd = []
+
+    def _execute(self, cmd):
+        op = cmd[0]
+        self.commands += 1
+        if op == 0x81:
+            self.contrast = cmd[1]
+        elif op in (0xA4, 0xA5):
+            self.all_on = op == 0xA5
+        elif op in (0xA6, 0xA7):
+            self.inverted = op == 0xA7
+        elif op in (0xAE, 0xAF):
+            self.display_on = op == 0xAF
+        elif op == 0x20:
+            self.mode = cmd[1] & 0x03
+        elif op == 0x21:
+            self.col_start, self.col_end = cmd[1] & 0x7F, cmd[2] & 0x7F
+            self.col = self.col_start
+        elif op == 0x22:
+            self.page_start, self.page_end = cmd[1] & 0x07, cmd[2] & 0x07
+            self.page = self.page_start
+        elif op <= 0x0F:
+            self.col = (self.col & 0xF0) | op
+        elif op <= 0x1F:
+            self.col = (self.col & 0x0F) | ((op & 0x0F) << 4)
+        elif 0x40 <= op <= 0x7F:
+            self.start_line = op & 0x3F
+        elif 0xB0 <= op <= 0xB7:
+            self.page = op & 0x07
+        elif op in (0xA0, 0xA1):
+            self.seg_remap = op == 0xA1
+        elif op in (0xC0, 0xC8):
+            self.com_scan_dec = op == 0xC8
+        elif op == 0xA8:
+            self.multiplex = cmd[1] & 0x3F
+        elif op == 0x2E:
+            self.scroll_active = False
+        elif op == 0x2F:
+            self.scroll_active = True
+        elif op in (0x2C, 0x2D):
+            self._content_scroll(op == 0x2D, cmd[2] & 0x07, cmd[4] & 0x07, cmd[5] & 0x7F, cmd[6] & 0x7F)
+
+    def _content_scroll(self, left, page_start, page_end, col_start, col_end):
+        for page in range(page_start, page_end + 1):
+            row = self.ram[page][col_start:col_end + 1]
+            row = row[1:] + row[:1] if left else row[-1:] + row[:-1]
+            self.ram[page][col_start:col_end + 1] = row
+
+    # data stream ----------------------------------------------------------
+
+    def data(self, data):
+        for byte in data:
+            self.ram[self.page][self.col] = byte
+            self.data_bytes += 1
+            self._advance()
+
+    def _advance(self):
+        if self.mode == MODE_PAGE:
+            if self.col < WIDTH - 1:
+                self.col += 1
+        elif self.mode == MODE_HORIZONTAL:
+            if self.col < self.col_end:
+                self.col += 1
+            else:
+                self.col = self.col_start
+                self.page = self.page_start if self.page >= self.page_end else self.page + 1
+        else:
+            if self.page < self.page_end:
+                self.page += 1
+            else:
+                self.page = self.page_start
+                self.col = self.col_start if self.col >= self.col_end else self.col + 1
+
+    # panel view -----------------------------------------------------------
+
+    def pixel(self, x, y):
+        """Pixel as seen on the panel with the library's orientation."""
+        if not self.display_on:
+            return 0
+        if self.all_on:
+            return 1
+        col = x if self.seg_remap else WIDTH - 1 - x
+        rows = self.multiplex + 1
+        row = y if self.com_scan_dec else rows - 1 - y
+        row = (row + self.start_line) % 64
+        bit = (self.ram[row // 8][col] >> (row % 8)) & 1
+        return bit ^ int(self.inverted)
+
+    def render(self, height=64):
+        return [[self.pixel(x, y) for x in range(WIDTH)] for y in range(height)]
+
+
+class Bus:
+    """Wire byte and time accounting."""
+
+    def __init__(self, bus, freq):
+        self.bus = bus
+        self.freq = freq
+        self.transfers = 0
+        self.wire_bytes = 0
+        self.bits = 0
+
+    def transfer(self, size):
+        self.transfers += 1
+        if self.bus == 'i2c':
+            # start, address, control byte, payload, stop; 9 clocks per byte
+            wire = size + 2
+            self.bits += wire * 9 + 2
+        else:
+            wire = size
+            self.bits += wire * 8
+        self.wire_bytes += wire
+
+    @property
+    def seconds(self):
+        return self.bits / float(self.freq)
+
+
+def run(lines, bus, verbose=False):
+    """Feed log lines through the models, return ({address: model}, mismatched pages)."""
+    models = {}
+    mismatches = 0
+    buffer_pages = {}
+
+    def check():
+        nonlocal mismatches
+        for (addr, page), row in buffer_pages.items():
+            model = models.setdefault(addr, SSD1306())
+            if model.ram[page][:len(row)] != row:
+                mismatches += 1
+                if verbose:
+                    diff = [i for i, (a, b) in enumerate(zip(model.ram[page], row)) if a != b]
+                    sys.stderr.write('panel %02X page %d differs at columns %s\n' % (addr, page, diff[:16]))
+        buffer_pages.clear()
+
+    for line in lines:
+        fields = line.split()
+        if len(fields) < 2:
+            continue
+        kind = fields[0]
+        if kind == 'B':
+            buffer_pages[(int(fields[1], 16), int(fields[2]))] = [int(v, 16) for v in fields[3:]]
+            continue
+        if buffer_pages:
+            check()
+        if kind not in ('C', 'D'):
+            continue
+        model = models.setdefault(int(fields[1], 16), SSD1306())
+        payload = [int(v, 16) for v in fields[2:]]
+        bus.transfer(len(payload))
+        if kind == 'C':
+            model.command(payload)
+        else:
+            model.data(payload)
+    if buffer_pages:
+        check()
+
+    return models, mismatches
+
+
+def write_pbm(path, image):
+    with open(path, 'w') as f:
+        f.write('P1\n%d %d\n' % (len(image[0]), len(image)))
+        for row in image:
+            f.write(' '.join(str(v) for v in row) + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('log', nargs='?', help='wire log (default stdin)')
+    parser.add_argument('--bus', choices=('i2c', 'spi'), default='i2c')
+    parser.add_argument('--freq', type=float, default=400000, help='bus clock in Hz')
+    parser.add_argument('--height', type=int, default=64, help='panel height')
+    parser.add_argument('--addr', type=lambda v: int(v, 16), help='panel address (hex) for image, default first seen')
+    parser.add_argument('--pbm', help='write panel image to PBM file')
+    parser.add_argument('--ascii', action='store_true', help='print panel image')
+    parser.add_argument('-v', '--verbose', action='store_true')
+    args = parser.parse_args()
+
+    lines = open(args.log) if args.log else sys.stdin
+    bus = Bus(args.bus, args.freq)
+    models, mismatches = run(lines, bus, args.verbose)
+    if not models:
+        sys.exit('no transfers in log')
+    addr = args.addr if args.addr is not None else next(iter(models))
+    if addr not in models:
+        sys.exit('no transfers to panel %02X' % addr)
+
+    print('transfers  %d' % bus.transfers)
+    for panel, model in models.items():
+        prefix = 'panel %02X ' % panel if len(models) > 1 else ''
+        print('%scommands   %d' % (prefix, model.commands))
+        print('%sdata bytes %d' % (prefix, model.data_bytes))
+    print('wire bytes %d' % bus.wire_bytes)
+    print('wire time  %.3f ms at %.0f Hz %s' % (bus.seconds * 1000, args.freq, args.bus))
+    print('mismatches %d' % mismatches)
+
+    image = models[addr].render(args.height)
+    if args.pbm:
+        write_pbm(args.pbm, image)
+    if args.ascii:
+        for row in image:
+            print(''.join('#' if v else '.' for v in row))
+
+    return 1 if mismatches else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Send PBM/XBM frames to ssd1306_stream_pump() over a serial line.
+
+Each frame is sent as sync byte 0xA5, start page, end page, start seg,
+end seg and the page-format payload for that window. With --delta only
+the bounding window of bytes that changed since the previous frame is
+sent. Set the serial port speed beforehand, e.g. `stty -F /dev/ttyUSB0
+1000000 raw`.
+
+    stream_frames.py -o /dev/ttyUSB0 --fps 15 --delta clip/*.pbm
+"""
+
+import argparse
+import sys
+import time
+
+from pbm2ssd1306 import read_pbm, read_xbm, to_pages
+
+SYNC = 0xA5
+
+
+def load(path, invert):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if path.lower().endswith('.xbm'):
+        width, height, rows = read_xbm(data.decode())
+    else:
+        width, height, rows = read_pbm(data)
+    pages, out = to_pages(width, height, rows, invert)
+    return width, pages, out
+
+
+def frame(page, seg, width, pages, data, previous):
+    """Return framed bytes for the window of data, or only its changes."""
+    start_page, end_page, start_seg, end_seg = 0, pages - 1, 0, width - 1
+    if previous is not None:
+        changed = [i for i, (a, b) in enumerate(zip(data, previous)) if a != b]
+        if not changed:
+            return b''
+        start_page, end_page = changed[0] // width, changed[-1] // width
+        columns = [i % width for i in changed]
+        start_seg, end_seg = min(columns), max(columns)
+    payload = bytearray()
+    for p in range(start_page, end_page + 1):
+        payload += bytes(data[p * width + start_seg:p * width + end_seg + 1])
+    header = bytes([SYNC, page + start_page, page + end_page, seg + start_seg, seg + end_seg])
+    return header + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('images', nargs='+', help='input .pbm or .xbm frames')
+    parser.add_argument('-o', '--output', help='serial device or file (default stdout)')
+    parser.add_argument('--page', type=int, default=0, help='display page of top edge')
+    parser.add_argument('--seg', type=int, default=0, help='display segment of left edge')
+    parser.add_argument('--fps', type=float, default=0, help='frame rate, 0 sends as fast as possible')
+    parser.add_argument('--delta', action='store_true', help='send only changed window of each frame')
+    parser.add_argument('-i', '--invert', action='store_true', help='invert pixels')
+    args = parser.parse_args()
+
+    out = open(args.output, 'wb', buffering=0) if args.output else sys.stdout.buffer
+    previous = None
+    sent = 0
+    due = time.monotonic()
+    for path in args.images:
+        width, pages, data = load(path, args.invert)
+        if args.page + pages > 8 or args.seg + width > 128:
+            sys.exit('%s does not fit at page %d seg %d' % (path, args.page, args.seg))
+        chunk = frame(args.page, args.seg, width, pages, data, previous if args.delta else None)
+        out.write(chunk)
+        out.flush()
+        sent += len(chunk)
+        previous = data
+        if args.fps:
+            due += 1.0 / args.fps
+            time.sleep(max(0.0, due - time.monotonic()))
+    sys.stderr.write('%d frames, %d bytes\n' % (len(args.images), sent))
+
+
+if __name__ == '__main__':
+    main()